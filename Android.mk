@@ -64,6 +64,7 @@ LOCAL_SRC_FILES := \
     src/waffle/core/wcore_util.c \
     src/waffle/core/wcore_display.c \
     src/waffle/core/wcore_attrib_list.c \
+    src/waffle/core/wcore_window_attrs.c \
     src/waffle/api/api_priv.c \
     src/waffle/api/waffle_attrib_list.c \
     src/waffle/api/waffle_config.c \
@@ -71,15 +72,19 @@ LOCAL_SRC_FILES := \
     src/waffle/api/waffle_display.c \
     src/waffle/api/waffle_enum.c \
     src/waffle/api/waffle_error.c \
+    src/waffle/api/waffle_fence.c \
     src/waffle/api/waffle_gl_misc.c \
+    src/waffle/api/waffle_image.c \
     src/waffle/api/waffle_init.c \
     src/waffle/api/waffle_window.c \
     src/waffle/api/waffle_dl.c \
+    src/waffle/linux/linux_device.c \
     src/waffle/linux/linux_dl.c \
     src/waffle/linux/linux_platform.c \
     src/waffle/egl/wegl_config.c \
     src/waffle/egl/wegl_context.c \
     src/waffle/egl/wegl_display.c \
+    src/waffle/egl/wegl_fence.c \
     src/waffle/egl/wegl_platform.c \
     src/waffle/egl/wegl_util.c \
     src/waffle/egl/wegl_window.c \
@@ -72,6 +72,22 @@ if(waffle_on_linux)
     # waffle_has_wayland
     waffle_pkg_config(wayland-client wayland-client>=1)
     waffle_pkg_config(wayland-egl wayland-egl>=9.1)
+    waffle_pkg_config(wayland-protocols wayland-protocols>=1.12)
+    waffle_pkg_config(wayland-scanner wayland-scanner>=1.15)
+    if(wayland-protocols_FOUND)
+        execute_process(
+            COMMAND ${PKG_CONFIG_EXECUTABLE} --variable=pkgdatadir wayland-protocols
+            OUTPUT_VARIABLE wayland-protocols_PKGDATADIR
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            )
+    endif()
+    if(wayland-scanner_FOUND)
+        execute_process(
+            COMMAND ${PKG_CONFIG_EXECUTABLE} --variable=wayland_scanner wayland-scanner
+            OUTPUT_VARIABLE wayland-scanner_EXECUTABLE
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            )
+    endif()
 
     # waffle_has_x11
     waffle_pkg_config(x11-xcb x11-xcb)
@@ -79,6 +95,7 @@ if(waffle_on_linux)
     # waffle_has_gbm
     waffle_pkg_config(gbm gbm)
     waffle_pkg_config(libudev libudev)
+    waffle_pkg_config(libdrm libdrm)
 endif()
 
 
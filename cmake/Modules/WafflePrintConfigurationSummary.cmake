@@ -61,6 +61,8 @@ endif()
 if(waffle_has_wayland)
     message("    wayland-client_INCLUDE_DIRS: ${wayland-client_INCLUDE_DIRS}")
     message("    wayland-egl_INCLUDE_DIRS:    ${wayland-egl_INCLUDE_DIRS}")
+    message("    wayland-protocols_PKGDATADIR: ${wayland-protocols_PKGDATADIR}")
+    message("    wayland-scanner_EXECUTABLE:   ${wayland-scanner_EXECUTABLE}")
 endif()
 if(waffle_has_x11)
     message("    x11-xcb_INCLUDE_DIRS: ${x11-xcb_INCLUDE_DIRS}")
@@ -68,6 +70,7 @@ if(waffle_has_x11)
 endif()
 if(waffle_has_gbm)
     message("    gbm_INCLUDE_DIRS: ${gbm_INCLUDE_DIRS}")
+    message("    libdrm_INCLUDE_DIRS: ${libdrm_INCLUDE_DIRS}")
 endif()
 message("")
 message("Build type:")
@@ -90,6 +90,11 @@ if(waffle_on_linux)
                 "${gbm_missing_deps} libudev"
                 )
         endif()
+        if(NOT libdrm_FOUND)
+            set(gbm_missing_deps
+                "${gbm_missing_deps} libdrm"
+                )
+        endif()
         if(NOT egl_FOUND)
             set(gbm_missing_deps
                 "${gbm_missing_deps} egl"
@@ -125,6 +130,16 @@ if(waffle_on_linux)
                 "${wayland_missing_deps} wayland-egl>=9.1"
                 )
         endif()
+        if(NOT wayland-protocols_FOUND)
+            set(wayland_missing_deps
+                "${wayland_missing_deps} wayland-protocols>=1.12"
+                )
+        endif()
+        if(NOT wayland-scanner_FOUND)
+            set(wayland_missing_deps
+                "${wayland_missing_deps} wayland-scanner>=1.15"
+                )
+        endif()
         if(NOT egl_FOUND)
             set(wayland_missing_deps
                 "${wayland_missing_deps} egl"
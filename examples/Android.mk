@@ -14,6 +14,7 @@ LOCAL_C_INCLUDES += $(LOCAL_PATH)/../src/waffle/
 
 LOCAL_SRC_FILES:= \
     gl_basic.c \
+    gl_basic_encode.c \
 
 LOCAL_SHARED_LIBRARIES := libwaffle-1
 
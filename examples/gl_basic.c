@@ -32,6 +32,10 @@
 ///     2. Create a window and OpenGL context.
 ///     3. Fill the window with red, then green, then blue, sleeping between
 ///        each buffer swap.
+///     4. Optionally write each frame to a file, reading it back through
+///        pixel buffer objects so that the readback does not stall rendering,
+///        and, where C11 threads are available, writing it from a separate
+///        thread.
 
 #define _POSIX_C_SOURCE 199309L // glibc feature macro for nanosleep.
 #define WAFFLE_API_VERSION 0x0106
@@ -41,9 +45,14 @@
 #include <getopt.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#if defined(GL_BASIC_HAS_THREADS)
+#include <threads.h>
+#endif
 #if !defined(_WIN32)
 #include <time.h>
 #else
@@ -60,6 +69,8 @@ removeXcodeArgs(int *argc, char **argv);
 
 #include "waffle.h"
 
+#include "gl_basic_encode.h"
+
 static const char *usage_message =
     "usage:\n"
     "    gl_basic --platform=android|cgl|gbm|glx|wayland|wgl|x11_egl\n"
@@ -71,6 +82,7 @@ static const char *usage_message =
     "             [--robust]\n"
     "             [--resize-window]\n"
     "             [--window-size=WIDTHxHEIGHT | --fullscreen]\n"
+    "             [--capture=FILE [--capture-format=raw|png|y4m]]\n"
     "\n"
     "examples:\n"
     "    gl_basic --platform=glx --api=gl\n"
@@ -95,6 +107,19 @@ static const char *usage_message =
     "\n"
     "    --fullscreen\n"
     "        Create a fullscreen window.\n"
+    "\n"
+    "    --capture=FILE\n"
+    "        Write each frame to FILE, from a separate thread if gl_basic\n"
+    "        was built with C11 threads. If the context\n"
+    "        has pixel buffer objects and fences (OpenGL 3.2 or OpenGL ES\n"
+    "        3.0), then frames are also read back asynchronously.\n"
+    "        Incompatible with --resize-window.\n"
+    "\n"
+    "    --capture-format=raw|png|y4m\n"
+    "        The format of --capture, which defaults to the extension of\n"
+    "        FILE, or raw. raw is RGBA, bottom row first. png writes one file\n"
+    "        per frame, inserting -N before the extension of FILE. y4m is a\n"
+    "        4:4:4 YUV4MPEG2 stream.\n"
     ;
 
 enum {
@@ -108,6 +133,8 @@ enum {
     OPT_RESIZE_WINDOW,
     OPT_WINDOW_SIZE,
     OPT_FULLSCREEN,
+    OPT_CAPTURE,
+    OPT_CAPTURE_FORMAT,
 };
 
 static const struct option get_opts[] = {
@@ -121,6 +148,8 @@ static const struct option get_opts[] = {
     { .name = "resize-window",  .has_arg = no_argument,           .val = OPT_RESIZE_WINDOW },
     { .name = "window-size",    .has_arg = required_argument,     .val = OPT_WINDOW_SIZE },
     { .name = "fullscreen",     .has_arg = no_argument,           .val = OPT_FULLSCREEN },
+    { .name = "capture",        .has_arg = required_argument,     .val = OPT_CAPTURE },
+    { .name = "capture-format", .has_arg = required_argument,     .val = OPT_CAPTURE_FORMAT },
     { 0 },
 };
 
@@ -190,15 +219,33 @@ error_get_gl_symbol(const char *name)
 typedef float GLclampf;
 typedef unsigned int GLbitfield;
 typedef unsigned int GLint;
+typedef unsigned int GLuint;
 typedef int GLsizei;
 typedef unsigned int GLenum;
+typedef unsigned char GLboolean;
+typedef unsigned char GLubyte;
 typedef void GLvoid;
+typedef ptrdiff_t GLintptr;
+typedef ptrdiff_t GLsizeiptr;
+typedef uint64_t GLuint64;
+typedef struct __GLsync *GLsync;
 
 enum {
     // Copied from <GL/gl*.h>.
     GL_UNSIGNED_BYTE =    0x00001401,
     GL_RGBA =             0x00001908,
     GL_COLOR_BUFFER_BIT = 0x00004000,
+    GL_VERSION =          0x00001f02,
+    GL_VIEWPORT =         0x00000ba2,
+
+    GL_MAP_READ_BIT = 0x0001,
+    GL_STREAM_READ = 0x88e1,
+    GL_PIXEL_PACK_BUFFER = 0x88eb,
+    GL_SYNC_FLUSH_COMMANDS_BIT = 0x00000001,
+    GL_SYNC_GPU_COMMANDS_COMPLETE = 0x9117,
+    GL_ALREADY_SIGNALED = 0x911a,
+    GL_TIMEOUT_EXPIRED = 0x911b,
+    GL_CONDITION_SATISFIED = 0x911c,
 
     GL_CONTEXT_FLAGS = 0x821e,
     GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT = 0x00000001,
@@ -224,6 +271,28 @@ static void (APIENTRY *glGetIntegerv)(GLenum pname, GLint *params);
 static void (APIENTRY *glReadPixels)(GLint x, GLint y, GLsizei width, GLsizei height,
                                      GLenum format, GLenum type, GLvoid* data);
 static void (APIENTRY *glViewport)(GLint x, GLint y, GLsizei width, GLsizei height);
+static const GLubyte *(APIENTRY *glGetString)(GLenum name);
+
+// For --capture. Null unless the context supports them.
+static void (APIENTRY *glGenBuffers)(GLsizei n, GLuint *buffers);
+static void (APIENTRY *glDeleteBuffers)(GLsizei n, const GLuint *buffers);
+static void (APIENTRY *glBindBuffer)(GLenum target, GLuint buffer);
+static void (APIENTRY *glBufferData)(GLenum target, GLsizeiptr size,
+                                     const GLvoid *data, GLenum usage);
+static void *(APIENTRY *glMapBufferRange)(GLenum target, GLintptr offset,
+                                          GLsizeiptr length, GLbitfield access);
+static GLboolean (APIENTRY *glUnmapBuffer)(GLenum target);
+static GLsync (APIENTRY *glFenceSync)(GLenum condition, GLbitfield flags);
+static GLenum (APIENTRY *glClientWaitSync)(GLsync sync, GLbitfield flags,
+                                           GLuint64 timeout);
+static void (APIENTRY *glDeleteSync)(GLsync sync);
+
+/// @brief File formats of --capture.
+enum capture_format {
+    CAPTURE_FORMAT_RAW = 1,
+    CAPTURE_FORMAT_PNG,
+    CAPTURE_FORMAT_Y4M,
+};
 
 /// @brief Command line options.
 struct options {
@@ -246,6 +315,13 @@ struct options {
 
     bool fullscreen;
 
+    /// @brief Null unless --capture is given.
+    const char *capture_filename;
+
+    /// @brief One of `CAPTURE_FORMAT_*`, or 0 to use the extension of
+    /// capture_filename.
+    int capture_format;
+
     /// @brief One of `WAFFLE_DL_*`.
     int dl;
 };
@@ -274,6 +350,13 @@ static const struct enum_map context_api_map[] = {
     {0,                             0           },
 };
 
+static const struct enum_map capture_format_map[] = {
+    {CAPTURE_FORMAT_RAW,    "raw"   },
+    {CAPTURE_FORMAT_PNG,    "png"   },
+    {CAPTURE_FORMAT_Y4M,    "y4m"   },
+    {0,                     0       },
+};
+
 /// @brief Translate string to `enum waffle_enum`.
 ///
 /// @param self is a list of map items. The last item must be zero-filled.
@@ -295,6 +378,20 @@ enum_map_translate_str(
     return false;
 }
 
+/// @brief Return the capture format named by the extension of @a filename,
+/// or raw if it names none.
+static int
+capture_format_from_filename(const char *filename)
+{
+    const char *ext = strrchr(filename, '.');
+    int format = CAPTURE_FORMAT_RAW;
+
+    if (ext && !strchr(ext, '/'))
+        enum_map_translate_str(capture_format_map, ext + 1, &format);
+
+    return format;
+}
+
 /// @return true on success.
 static bool
 parse_args(int argc, char *argv[], struct options *opts)
@@ -385,6 +482,17 @@ parse_args(int argc, char *argv[], struct options *opts)
             case OPT_FULLSCREEN:
                 opts->fullscreen = true;
                 break;
+            case OPT_CAPTURE:
+                opts->capture_filename = optarg;
+                break;
+            case OPT_CAPTURE_FORMAT:
+                ok = enum_map_translate_str(capture_format_map, optarg,
+                                            &opts->capture_format);
+                if (!ok) {
+                    usage_error_printf("'%s' is not a valid capture format",
+                                       optarg);
+                }
+                break;
             default:
                 abort();
                 loop_get_opt = false;
@@ -409,6 +517,20 @@ parse_args(int argc, char *argv[], struct options *opts)
                            "exclusive options");
     }
 
+    if (opts->capture_filename && opts->resize_window) {
+        usage_error_printf("--capture and --resize-window are mutually "
+                           "exclusive options");
+    }
+
+    if (opts->capture_format && !opts->capture_filename) {
+        usage_error_printf("--capture-format requires --capture");
+    }
+
+    if (opts->capture_filename && !opts->capture_format) {
+        opts->capture_format =
+            capture_format_from_filename(opts->capture_filename);
+    }
+
     // Set dl.
     switch (opts->context_api) {
         case WAFFLE_CONTEXT_OPENGL:     opts->dl = WAFFLE_DL_OPENGL;      break;
@@ -449,8 +571,420 @@ get_gl_symbol(const struct options *opts, const const char *name)
     return sym;
 }
 
+/// @brief Return true if the window holds frame @a i's color.
+static bool
+check_frame(const unsigned char *colors, int width, int height, int i)
+{
+    for (int j = 0; j < width * height * 4; j += 4) {
+       if ((colors[j]   != (i == 0 ? 0xff : 0)) ||
+           (colors[j+1] != (i == 1 ? 0xff : 0)) ||
+           (colors[j+2] != (i == 2 ? 0xff : 0)) ||
+           (colors[j+3] != 0xff)) {
+          return false;
+       }
+    }
+
+    return true;
+}
+
+/// @brief Number of frames whose readback may be in flight.
+#define CAPTURE_DEPTH 3
+
+#if defined(GL_BASIC_HAS_THREADS)
+/// @brief Number of read frames that may wait for the writer thread.
+#define CAPTURE_QUEUE_MAX 8
+#endif
+
+/// @brief A frame read back from the GPU, bottom row first.
+struct capture_item {
+    struct capture_item *next;
+    unsigned char *colors;
+    int frame;
+};
+
+/// @brief Writes the frames drawn by draw() to files.
+///
+/// If the context has pixel buffer objects and fences, then each frame is
+/// read into a buffer object, and is handed on only once its fence has
+/// signaled, usually a frame or two later. Otherwise each frame is read
+/// synchronously. Either way, if the build defines GL_BASIC_HAS_THREADS for
+/// C11 threads, then a writer thread encodes and writes the frames, so the
+/// render thread never waits for the file. Otherwise the render thread
+/// writes them.
+struct capture {
+    /// @brief One of `CAPTURE_FORMAT_*`.
+    int format;
+    const char *filename;
+    int width;
+    int height;
+
+    // Used only by the render thread.
+    bool async;
+    GLuint buffers[CAPTURE_DEPTH];
+    GLsync fences[CAPTURE_DEPTH];
+
+    /// @brief The index of the frame in each slot, for check_frame().
+    int frames[CAPTURE_DEPTH];
+
+    /// @brief Slots in flight, oldest first.
+    int head;
+    int count;
+
+#if defined(GL_BASIC_HAS_THREADS)
+    // The queue of read frames, guarded by mutex.
+    mtx_t mutex;
+    cnd_t cond;
+    struct capture_item *first;
+    struct capture_item *last;
+    int queued;
+    bool finished;
+
+    thrd_t writer;
+#endif
+
+    // Used only by the writer thread, if any, until it is joined.
+    FILE *file;
+    bool failed;
+};
+
+/// @brief Return true if the current context has OpenGL 3.2 or OpenGL ES 3.0.
+static bool
+capture_can_be_async(const struct options *opts)
+{
+    const char *version = (const char *) glGetString(GL_VERSION);
+    int major = 0;
+    int minor = 0;
+
+    if (!version)
+        return false;
+
+    // Skip the "OpenGL ES " prefix of OpenGL ES versions.
+    while (*version && (*version < '0' || *version > '9'))
+        ++version;
+
+    if (sscanf(version, "%d.%d", &major, &minor) != 2)
+        return false;
+
+    if (opts->context_api == WAFFLE_CONTEXT_OPENGL)
+        return 10 * major + minor >= 32;
+    else
+        return major >= 3;
+}
+
+/// @brief Write one PNG file per frame, named by inserting "-N" before the
+/// extension of the --capture file.
+static bool
+capture_write_png(struct capture *cap, const unsigned char *colors, int frame)
+{
+    const char *ext = strrchr(cap->filename, '.');
+    char *filename;
+    size_t size;
+    FILE *file;
+    bool ok;
+
+    if (!ext || strchr(ext, '/'))
+        ext = cap->filename + strlen(cap->filename);
+
+    size = strlen(cap->filename) + 16;
+    filename = malloc(size);
+    if (!filename)
+        return false;
+
+    snprintf(filename, size, "%.*s-%d%s",
+             (int) (ext - cap->filename), cap->filename, frame, ext);
+
+    file = fopen(filename, "wb");
+    free(filename);
+    if (!file)
+        return false;
+
+    ok = png_write(file, colors, cap->width, cap->height);
+    ok &= fclose(file) == 0;
+    return ok;
+}
+
+static bool
+capture_write(struct capture *cap, const struct capture_item *item)
+{
+    size_t size = (size_t) cap->width * cap->height * 4;
+
+    switch (cap->format) {
+        case CAPTURE_FORMAT_RAW:
+            return fwrite(item->colors, 1, size, cap->file) == size;
+        case CAPTURE_FORMAT_PNG:
+            return capture_write_png(cap, item->colors, item->frame);
+        case CAPTURE_FORMAT_Y4M:
+            return y4m_write(cap->file, item->colors, cap->width, cap->height);
+        default:
+            abort();
+    }
+}
+
+/// @brief Check and write a frame, and free it.
+static void
+capture_consume(struct capture *cap, struct capture_item *item)
+{
+    if (!check_frame(item->colors, cap->width, cap->height, item->frame))
+        fprintf(stderr, "glReadPixels returned unexpected result\n");
+
+    // After a failure, keep consuming frames so the render thread never
+    // blocks.
+    if (!cap->failed && !capture_write(cap, item))
+        cap->failed = true;
+
+    free(item->colors);
+    free(item);
+}
+
+#if defined(GL_BASIC_HAS_THREADS)
+/// @brief The writer thread. Check and write the queued frames until
+/// capture_finish().
+static int
+capture_writer_main(void *arg)
+{
+    struct capture *cap = arg;
+
+    for (;;) {
+        struct capture_item *item;
+
+        mtx_lock(&cap->mutex);
+        while (!cap->first && !cap->finished)
+            cnd_wait(&cap->cond, &cap->mutex);
+
+        item = cap->first;
+        if (item) {
+            cap->first = item->next;
+            if (!cap->first)
+                cap->last = NULL;
+            cap->queued--;
+            cnd_broadcast(&cap->cond);
+        }
+        mtx_unlock(&cap->mutex);
+
+        if (!item)
+            return 0;
+
+        capture_consume(cap, item);
+    }
+}
+#endif
+
+/// @brief Hand @a colors, which holds frame @a frame, to the writer thread,
+/// which frees it.
+///
+/// Block only if the writer has fallen CAPTURE_QUEUE_MAX frames behind.
+/// Without a writer thread, write the frame now.
+static void
+capture_queue(struct capture *cap, unsigned char *colors, int frame)
+{
+    struct capture_item *item = calloc(1, sizeof(*item));
+
+    if (!item)
+        error_printf("out of memory");
+
+    item->colors = colors;
+    item->frame = frame;
+
+#if defined(GL_BASIC_HAS_THREADS)
+    mtx_lock(&cap->mutex);
+    while (cap->queued == CAPTURE_QUEUE_MAX)
+        cnd_wait(&cap->cond, &cap->mutex);
+
+    if (cap->last)
+        cap->last->next = item;
+    else
+        cap->first = item;
+    cap->last = item;
+    cap->queued++;
+
+    cnd_broadcast(&cap->cond);
+    mtx_unlock(&cap->mutex);
+#else
+    capture_consume(cap, item);
+#endif
+}
+
+static void
+capture_init(struct capture *cap, const struct options *opts,
+             int width, int height)
+{
+    cap->format = opts->capture_format;
+    cap->filename = opts->capture_filename;
+    cap->width = width;
+    cap->height = height;
+
+    // PNG writes a file per frame.
+    if (cap->format != CAPTURE_FORMAT_PNG) {
+        cap->file = fopen(cap->filename, "wb");
+        if (!cap->file)
+            error_printf("failed to open %s", cap->filename);
+    }
+
+    if (cap->format == CAPTURE_FORMAT_Y4M) {
+        // gl_basic presents two frames per second.
+        if (fprintf(cap->file, "YUV4MPEG2 W%d H%d F2:1 Ip A1:1 C444\n",
+                    width, height) < 0)
+            error_printf("failed to write %s", cap->filename);
+    }
+
+#if defined(GL_BASIC_HAS_THREADS)
+    if (mtx_init(&cap->mutex, mtx_plain) != thrd_success ||
+        cnd_init(&cap->cond) != thrd_success ||
+        thrd_create(&cap->writer, capture_writer_main, cap) != thrd_success)
+        error_printf("failed to start the capture writer thread");
+#endif
+
+    if (!capture_can_be_async(opts))
+        return;
+
+    glGenBuffers = get_gl_symbol(opts, "glGenBuffers");
+    glDeleteBuffers = get_gl_symbol(opts, "glDeleteBuffers");
+    glBindBuffer = get_gl_symbol(opts, "glBindBuffer");
+    glBufferData = get_gl_symbol(opts, "glBufferData");
+    glMapBufferRange = get_gl_symbol(opts, "glMapBufferRange");
+    glUnmapBuffer = get_gl_symbol(opts, "glUnmapBuffer");
+    glFenceSync = get_gl_symbol(opts, "glFenceSync");
+    glClientWaitSync = get_gl_symbol(opts, "glClientWaitSync");
+    glDeleteSync = get_gl_symbol(opts, "glDeleteSync");
+
+    if (!glGenBuffers || !glDeleteBuffers || !glBindBuffer ||
+        !glBufferData || !glMapBufferRange || !glUnmapBuffer ||
+        !glFenceSync || !glClientWaitSync || !glDeleteSync)
+        return;
+
+    glGenBuffers(CAPTURE_DEPTH, cap->buffers);
+    for (int i = 0; i < CAPTURE_DEPTH; ++i) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, cap->buffers[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, width * height * 4, NULL,
+                     GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (glGetError())
+        error_printf("failed to create pixel buffer objects");
+
+    cap->async = true;
+}
+
+/// @brief Queue the oldest frame in flight if its readback is complete, or
+/// if @a wait, once it completes.
+///
+/// @return true if the frame was queued.
 static bool
-draw(struct waffle_window *window, bool resize)
+capture_retire(struct capture *cap, bool wait)
+{
+    size_t size = (size_t) cap->width * cap->height * 4;
+    int slot = cap->head;
+    const unsigned char *mapped;
+    unsigned char *colors;
+    GLenum status;
+
+    status = glClientWaitSync(cap->fences[slot],
+                              wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                              wait ? UINT64_MAX : 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+        return false;
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+        error_printf("glClientWaitSync failed");
+
+    glDeleteSync(cap->fences[slot]);
+    cap->fences[slot] = NULL;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, cap->buffers[slot]);
+    mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (!mapped)
+        error_printf("glMapBufferRange failed");
+
+    // Copy the frame out so the buffer can be reused before the writer
+    // thread gets to it.
+    colors = malloc(size);
+    if (!colors)
+        error_printf("out of memory");
+
+    memcpy(colors, mapped, size);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    capture_queue(cap, colors, cap->frames[slot]);
+
+    cap->head = (cap->head + 1) % CAPTURE_DEPTH;
+    cap->count--;
+    return true;
+}
+
+/// @brief Capture the back buffer, which holds frame @a frame.
+static void
+capture_frame(struct capture *cap, int frame)
+{
+    unsigned char *colors;
+    int slot;
+
+    if (!cap->async) {
+        colors = calloc(cap->width * cap->height * 4, sizeof(*colors));
+        if (!colors)
+            error_printf("out of memory");
+
+        glReadPixels(0, 0, cap->width, cap->height,
+                     GL_RGBA, GL_UNSIGNED_BYTE, colors);
+        capture_queue(cap, colors, frame);
+        return;
+    }
+
+    // Queue the frames whose readback is already complete. If every slot is
+    // still in flight, then wait for the oldest.
+    while (cap->count > 0 && capture_retire(cap, false))
+        continue;
+    if (cap->count == CAPTURE_DEPTH)
+        capture_retire(cap, true);
+
+    slot = (cap->head + cap->count) % CAPTURE_DEPTH;
+
+    // With a pack buffer bound, glReadPixels only queues the copy.
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, cap->buffers[slot]);
+    glReadPixels(0, 0, cap->width, cap->height,
+                 GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    cap->fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (!cap->fences[slot])
+        error_printf("glFenceSync failed");
+
+    cap->frames[slot] = frame;
+    cap->count++;
+}
+
+/// @brief Write the frames in flight, stop the writer thread and close the
+/// file.
+static void
+capture_finish(struct capture *cap)
+{
+    if (cap->async) {
+        while (cap->count > 0)
+            capture_retire(cap, true);
+
+        glDeleteBuffers(CAPTURE_DEPTH, cap->buffers);
+    }
+
+#if defined(GL_BASIC_HAS_THREADS)
+    mtx_lock(&cap->mutex);
+    cap->finished = true;
+    cnd_broadcast(&cap->cond);
+    mtx_unlock(&cap->mutex);
+
+    thrd_join(cap->writer, NULL);
+    cnd_destroy(&cap->cond);
+    mtx_destroy(&cap->mutex);
+#endif
+
+    if (cap->file && fclose(cap->file) != 0)
+        cap->failed = true;
+
+    if (cap->failed)
+        error_printf("failed to write captured frames");
+}
+
+static bool
+draw(struct waffle_window *window, bool resize, struct capture *cap)
 {
     bool ok;
     unsigned char *colors;
@@ -482,21 +1016,19 @@ draw(struct waffle_window *window, bool resize)
 
         glClear(GL_COLOR_BUFFER_BIT);
 
-        colors = calloc(width * height * 4, sizeof(*colors));
-        glReadPixels(0, 0,
-                     width, height,
-                     GL_RGBA, GL_UNSIGNED_BYTE,
-                     colors);
-        for (int j = 0; j < width * height * 4; j += 4) {
-           if ((colors[j]   != (i == 0 ? 0xff : 0)) ||
-               (colors[j+1] != (i == 1 ? 0xff : 0)) ||
-               (colors[j+2] != (i == 2 ? 0xff : 0)) ||
-               (colors[j+3] != 0xff)) {
-              fprintf(stderr, "glReadPixels returned unexpected result\n");
-              break;
-           }
+        if (cap) {
+            // The capture checks the frame when it writes it.
+            capture_frame(cap, i);
+        } else {
+            colors = calloc(width * height * 4, sizeof(*colors));
+            glReadPixels(0, 0,
+                         width, height,
+                         GL_RGBA, GL_UNSIGNED_BYTE,
+                         colors);
+            if (!check_frame(colors, width, height, i))
+                fprintf(stderr, "glReadPixels returned unexpected result\n");
+            free(colors);
         }
-        free(colors);
 
         if (i == 0) {
             ok = waffle_window_show(window);
@@ -602,6 +1134,8 @@ main(int argc, char **argv)
     struct waffle_context *ctx;
     struct waffle_window *window;
 
+    struct capture cap = {0};
+
     GLint context_flags = 0;
 
     #ifdef __APPLE__
@@ -663,6 +1197,10 @@ main(int argc, char **argv)
     if (!glViewport)
         error_get_gl_symbol("glViewport");
 
+    glGetString = get_gl_symbol(&opts, "glGetString");
+    if (!glGetString)
+        error_get_gl_symbol("glGetString");
+
     i = 0;
     config_attrib_list[i++] = WAFFLE_CONTEXT_API;
     config_attrib_list[i++] = opts.context_api;
@@ -758,10 +1296,22 @@ main(int argc, char **argv)
     // a context is robust varies on the combination of context profile,
     // context version, and supported extensions.
 
-    ok = draw(window, opts.resize_window);
+    if (opts.capture_filename) {
+        // A fullscreen window has the size that the platform chose.
+        GLint viewport[4];
+
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        capture_init(&cap, &opts, viewport[2], viewport[3]);
+    }
+
+    ok = draw(window, opts.resize_window,
+              opts.capture_filename ? &cap : NULL);
     if (!ok)
         error_waffle();
 
+    if (opts.capture_filename)
+        capture_finish(&cap);
+
     ok = waffle_make_current(dpy, NULL, NULL);
     if (!ok)
         error_waffle();
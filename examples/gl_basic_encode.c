@@ -0,0 +1,213 @@
+// Copyright 2012 - 2014 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/// @file
+/// @brief Image encoders for gl_basic's --capture option.
+///
+/// They need no library, so that the example builds anywhere waffle does.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gl_basic_encode.h"
+
+static uint32_t png_crc_table[256];
+
+static void
+png_crc_init(void)
+{
+    static bool initialized;
+
+    if (initialized)
+        return;
+
+    initialized = true;
+
+    for (uint32_t n = 0; n < 256; ++n) {
+        uint32_t c = n;
+
+        for (int k = 0; k < 8; ++k)
+            c = c & 1 ? 0xedb88320 ^ (c >> 1) : c >> 1;
+
+        png_crc_table[n] = c;
+    }
+}
+
+static uint32_t
+png_crc(uint32_t crc, const unsigned char *buf, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+        crc = png_crc_table[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
+
+    return crc;
+}
+
+static void
+put_be32(unsigned char *p, uint32_t v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static bool
+png_write_chunk(FILE *file, const char *type,
+                const unsigned char *data, size_t len)
+{
+    unsigned char head[8];
+    unsigned char tail[4];
+    uint32_t crc;
+
+    put_be32(head, len);
+    memcpy(head + 4, type, 4);
+
+    crc = png_crc(0xffffffff, head + 4, 4);
+    crc = png_crc(crc, data, len);
+    put_be32(tail, crc ^ 0xffffffff);
+
+    return fwrite(head, 1, sizeof(head), file) == sizeof(head) &&
+           fwrite(data, 1, len, file) == len &&
+           fwrite(tail, 1, sizeof(tail), file) == sizeof(tail);
+}
+
+bool
+png_write(FILE *file, const unsigned char *colors, int width, int height)
+{
+    static const unsigned char signature[8] = {
+        0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n',
+    };
+    const size_t stride = (size_t) width * 4;
+    const size_t raw_size = (stride + 1) * height;
+    const size_t num_blocks = (raw_size + 0xfffe) / 0xffff;
+    unsigned char ihdr[13];
+    unsigned char *idat;
+    unsigned char *p;
+    uint32_t a = 1;
+    uint32_t b = 0;
+    size_t left = raw_size;
+    int row = 0;
+    size_t col = 0;
+    bool ok;
+
+    png_crc_init();
+
+    put_be32(ihdr, width);
+    put_be32(ihdr + 4, height);
+    ihdr[8] = 8;     // bit depth
+    ihdr[9] = 6;     // RGBA
+    ihdr[10] = 0;    // deflate
+    ihdr[11] = 0;    // no filter
+    ihdr[12] = 0;    // no interlace
+
+    idat = malloc(2 + raw_size + 5 * num_blocks + 4);
+    if (!idat)
+        return false;
+
+    // A zlib stream of stored deflate blocks.
+    p = idat;
+    *p++ = 0x78;
+    *p++ = 0x01;
+
+    while (left > 0) {
+        size_t len = left < 0xffff ? left : 0xffff;
+
+        left -= len;
+        *p++ = left == 0;
+        *p++ = len;
+        *p++ = len >> 8;
+        *p++ = ~len;
+        *p++ = ~len >> 8;
+
+        // Each row starts with filter type 0. PNG stores the top row first.
+        for (; len > 0; --len) {
+            unsigned char c;
+
+            if (col == 0)
+                c = 0;
+            else
+                c = colors[(height - 1 - row) * stride + col - 1];
+
+            if (++col == stride + 1) {
+                col = 0;
+                ++row;
+            }
+
+            *p++ = c;
+            a = (a + c) % 65521;
+            b = (b + a) % 65521;
+        }
+    }
+
+    put_be32(p, b << 16 | a);
+    p += 4;
+
+    ok = fwrite(signature, 1, sizeof(signature), file) == sizeof(signature) &&
+         png_write_chunk(file, "IHDR", ihdr, sizeof(ihdr)) &&
+         png_write_chunk(file, "IDAT", idat, p - idat) &&
+         png_write_chunk(file, "IEND", NULL, 0);
+
+    free(idat);
+    return ok;
+}
+
+bool
+y4m_write(FILE *file, const unsigned char *colors, int width, int height)
+{
+    const size_t plane = (size_t) width * height;
+    unsigned char *ycbcr;
+    bool ok;
+
+    ycbcr = malloc(3 * plane);
+    if (!ycbcr)
+        return false;
+
+    // y4m stores the top row first.
+    for (int y = 0; y < height; ++y) {
+        const unsigned char *src = &colors[(size_t) (height - 1 - y) * width * 4];
+        size_t i = (size_t) y * width;
+
+        for (int x = 0; x < width; ++x, src += 4, ++i) {
+            int r = src[0];
+            int g = src[1];
+            int b = src[2];
+
+            // The offsets keep the shifted values non-negative.
+            ycbcr[i] = (66 * r + 129 * g + 25 * b + (16 << 8) + 128) >> 8;
+            ycbcr[plane + i] = (-38 * r - 74 * g + 112 * b + (128 << 8) + 128) >> 8;
+            ycbcr[2 * plane + i] = (112 * r - 94 * g - 18 * b + (128 << 8) + 128) >> 8;
+        }
+    }
+
+    ok = fputs("FRAME\n", file) != EOF &&
+         fwrite(ycbcr, 1, 3 * plane, file) == 3 * plane;
+
+    free(ycbcr);
+    return ok;
+}
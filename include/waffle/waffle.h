@@ -140,6 +140,17 @@ enum waffle_enum {
     WAFFLE_CONTEXT_FORWARD_COMPATIBLE                           = 0x0215,
     WAFFLE_CONTEXT_DEBUG                                        = 0x0216,
     WAFFLE_CONTEXT_ROBUST_ACCESS                                = 0x0217,
+    WAFFLE_CONTEXT_NO_ERROR                                     = 0x0218,
+
+    WAFFLE_CONTEXT_PRIORITY                                     = 0x0219,
+        WAFFLE_CONTEXT_PRIORITY_LOW                             = 0x021a,
+        WAFFLE_CONTEXT_PRIORITY_MEDIUM                          = 0x021b,
+        WAFFLE_CONTEXT_PRIORITY_HIGH                            = 0x021c,
+        WAFFLE_CONTEXT_PRIORITY_REALTIME                        = 0x021d,
+
+    WAFFLE_CONTEXT_RELEASE_BEHAVIOR                             = 0x021e,
+        WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH                   = 0x021f,
+        WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE                    = 0x0220,
 
     WAFFLE_RED_SIZE                                             = 0x0201,
     WAFFLE_GREEN_SIZE                                           = 0x0202,
@@ -172,6 +183,14 @@ enum waffle_enum {
     WAFFLE_WINDOW_WIDTH                                         = 0x0310,
     WAFFLE_WINDOW_HEIGHT                                        = 0x0311,
     WAFFLE_WINDOW_FULLSCREEN                                    = 0x0312,
+    WAFFLE_WINDOW_RENDER_WIDTH                                  = 0x0313,
+    WAFFLE_WINDOW_RENDER_HEIGHT                                 = 0x0314,
+    WAFFLE_WINDOW_PARENT                                        = 0x0315,
+    WAFFLE_WINDOW_BYPASS_COMPOSITOR                             = 0x0316,
+    WAFFLE_WINDOW_GBM_MODIFIERS                                 = 0x0317,
+    WAFFLE_WINDOW_GBM_USAGE                                     = 0x0318,
+    WAFFLE_WINDOW_GBM_MODIFIER                                  = 0x0319,
+    WAFFLE_WINDOW_BUFFER_COUNT                                  = 0x031a,
 };
 
 const char*
@@ -227,6 +246,46 @@ waffle_display_supports_context_api(struct waffle_display *self,
 union waffle_native_display*
 waffle_display_get_native(struct waffle_display *self);
 
+#if defined(WAFFLE_API_EXPERIMENTAL) && WAFFLE_API_VERSION >= 0x0106
+struct waffle_display*
+waffle_display_adopt_native(union waffle_native_display *native);
+#endif
+
+// ---------------------------------------------------------------------------
+// waffle_device
+// ---------------------------------------------------------------------------
+
+#if defined(WAFFLE_API_EXPERIMENTAL) && WAFFLE_API_VERSION >= 0x0106
+/// @brief A GPU that the platform can use.
+///
+/// On X11 and Wayland the display server chooses the GPU, and
+/// waffle_display_connect() does not select an EGL device, so there the list
+/// is informational.
+struct waffle_device_info {
+    /// @brief The DRM device node.
+    ///
+    /// On GBM, the render node, or the card node if the GPU has no render
+    /// node. waffle_display_connect() accepts it.
+    char name[256];
+
+    /// Zero if the device is not on PCI.
+    uint32_t pci_vendor_id;
+    uint32_t pci_device_id;
+
+    /// The kernel driver, such as "i915" or "amdgpu". Empty if unknown.
+    char driver[64];
+};
+
+/// Fill at most @a max_devices entries of @a devices, which may be null if
+/// @a max_devices is 0, and set @a num_devices to the number of devices.
+/// Each GPU is listed once.
+bool
+waffle_enumerate_devices(
+        struct waffle_device_info devices[],
+        int32_t max_devices,
+        int32_t *num_devices);
+#endif
+
 // ---------------------------------------------------------------------------
 // waffle_config
 // ---------------------------------------------------------------------------
@@ -255,6 +314,56 @@ waffle_context_destroy(struct waffle_context *self);
 union waffle_native_context*
 waffle_context_get_native(struct waffle_context *self);
 
+#if defined(WAFFLE_API_EXPERIMENTAL) && WAFFLE_API_VERSION >= 0x0106
+bool
+waffle_context_get_attrib(
+        struct waffle_context *self,
+        int32_t attrib,
+        intptr_t *value);
+
+struct waffle_context*
+waffle_context_create_no_config(
+        struct waffle_display *dpy,
+        const int32_t attrib_list[],
+        struct waffle_context *shared_ctx);
+#endif
+
+// ---------------------------------------------------------------------------
+// waffle_dmabuf
+// ---------------------------------------------------------------------------
+
+#if defined(WAFFLE_API_EXPERIMENTAL) && WAFFLE_API_VERSION >= 0x0106
+#define WAFFLE_DMABUF_MAX_PLANES 4
+
+/// A buffer shared as Linux dma-buf file descriptors, one per plane.
+struct waffle_dmabuf {
+    int32_t width;
+    int32_t height;
+
+    /// A DRM_FORMAT_* code from drm_fourcc.h.
+    uint32_t fourcc;
+
+    /// A DRM_FORMAT_MOD_* code, or DRM_FORMAT_MOD_INVALID if unknown.
+    uint64_t modifier;
+
+    int32_t num_planes;
+    int fds[WAFFLE_DMABUF_MAX_PLANES];
+    uint32_t offsets[WAFFLE_DMABUF_MAX_PLANES];
+    uint32_t strides[WAFFLE_DMABUF_MAX_PLANES];
+};
+
+/// A read-only CPU mapping of a window's presented buffer.
+struct waffle_mapped_frame {
+    const void *data;
+    int32_t width;
+    int32_t height;
+    uint32_t stride;
+
+    /// A DRM_FORMAT_* code from drm_fourcc.h.
+    uint32_t fourcc;
+};
+#endif
+
 // ---------------------------------------------------------------------------
 // waffle_window
 // ---------------------------------------------------------------------------
@@ -284,6 +393,50 @@ waffle_window_swap_buffers(struct waffle_window *self);
 union waffle_native_window*
 waffle_window_get_native(struct waffle_window *self);
 
+#if defined(WAFFLE_API_EXPERIMENTAL) && WAFFLE_API_VERSION >= 0x0106
+bool
+waffle_window_get_attrib(
+        struct waffle_window *self,
+        int32_t attrib,
+        intptr_t *value);
+
+bool
+waffle_window_create_many(
+        struct waffle_config *config,
+        const intptr_t attrib_list[],
+        int32_t count,
+        struct waffle_window *windows[]);
+
+struct waffle_window*
+waffle_window_adopt_native(
+        struct waffle_config *config,
+        union waffle_native_window *native);
+
+/// Export the last presented buffer. The buffer is not reused until
+/// waffle_window_release_frame() releases the export, or until the window is
+/// destroyed.
+bool
+waffle_window_export_frame(
+        struct waffle_window *self,
+        struct waffle_dmabuf *frame);
+
+/// Release the oldest frame exported by waffle_window_export_frame() and not
+/// yet released, letting its buffer return to the window.
+bool
+waffle_window_release_frame(struct waffle_window *self);
+
+/// Map the last presented buffer for reading. The mapping lasts until
+/// waffle_window_unmap_front_buffer(), or until the window is swapped,
+/// resized or destroyed.
+bool
+waffle_window_map_front_buffer(
+        struct waffle_window *self,
+        struct waffle_mapped_frame *frame);
+
+bool
+waffle_window_unmap_front_buffer(struct waffle_window *self);
+#endif
+
 #if defined(WAFFLE_API_EXPERIMENTAL) && WAFFLE_API_VERSION >= 0x0103
 bool
 waffle_window_resize(
@@ -292,6 +445,93 @@ waffle_window_resize(
         int32_t height);
 #endif
 
+// ---------------------------------------------------------------------------
+// waffle_image
+// ---------------------------------------------------------------------------
+
+#if defined(WAFFLE_API_EXPERIMENTAL) && WAFFLE_API_VERSION >= 0x0106
+struct waffle_image;
+
+struct waffle_image*
+waffle_image_create_from_dmabuf(
+        struct waffle_display *dpy,
+        const struct waffle_dmabuf *dmabuf);
+
+/// Create an image that shares the storage of level 0 of a GL_TEXTURE_2D
+/// texture of @a ctx, whose size is @a width x @a height. The context need not
+/// be current.
+///
+/// Any context of the same display may bind the image, whatever its share
+/// group or thread. To use it on another display, export it with
+/// waffle_image_export_dmabuf() and import it there. Rendering to the texture
+/// must complete, e.g. with glFinish(), before another context samples it.
+struct waffle_image*
+waffle_image_create_from_texture(
+        struct waffle_context *ctx,
+        uint32_t texture,
+        int32_t width,
+        int32_t height);
+
+/// The caller owns the fds returned in @a dmabuf.
+bool
+waffle_image_export_dmabuf(
+        struct waffle_image *self,
+        struct waffle_dmabuf *dmabuf);
+
+bool
+waffle_image_destroy(struct waffle_image *self);
+
+/// Define the storage of the texture bound to @a target in the current
+/// context, which must belong to the image's display, as the image.
+/// @a target is GL_TEXTURE_2D or GL_TEXTURE_EXTERNAL_OES.
+bool
+waffle_image_bind_texture(
+        struct waffle_image *self,
+        uint32_t target);
+#endif
+
+// ---------------------------------------------------------------------------
+// waffle_fence
+// ---------------------------------------------------------------------------
+
+#if defined(WAFFLE_API_EXPERIMENTAL) && WAFFLE_API_VERSION >= 0x0106
+struct waffle_fence;
+
+/// A timeout for waffle_fence_wait() that never expires.
+#define WAFFLE_FENCE_FOREVER UINT64_MAX
+
+/// Create a fence that signals once the commands that @a ctx has issued so
+/// far complete. @a ctx must be current to the calling thread.
+///
+/// On GLX the fence is a GL sync object, so the other fence functions need
+/// a current context that shares objects with @a ctx.
+struct waffle_fence*
+waffle_fence_create(struct waffle_context *ctx);
+
+bool
+waffle_fence_destroy(struct waffle_fence *self);
+
+/// Block until the fence signals or @a timeout_ns nanoseconds pass, and set
+/// @a signaled to which happened. Flush the current context first.
+bool
+waffle_fence_wait(
+        struct waffle_fence *self,
+        uint64_t timeout_ns,
+        bool *signaled);
+
+/// Make the current context wait for the fence before it executes any
+/// further commands, without blocking the calling thread.
+bool
+waffle_fence_server_wait(struct waffle_fence *self);
+
+/// Return in @a fd a sync file that signals with the fence. The caller owns
+/// it.
+bool
+waffle_fence_export_fd(
+        struct waffle_fence *self,
+        int *fd);
+#endif
+
 // ---------------------------------------------------------------------------
 // waffle_dl
 // ---------------------------------------------------------------------------
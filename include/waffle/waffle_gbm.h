@@ -39,6 +39,12 @@ extern "C" {
 struct gbm_device;
 struct gbm_surface;
 
+/// Bits of the WAFFLE_WINDOW_GBM_USAGE window attribute. Buffers are always
+/// usable for rendering.
+#define WAFFLE_GBM_USAGE_SCANOUT    0x1
+#define WAFFLE_GBM_USAGE_LINEAR     0x2
+#define WAFFLE_GBM_USAGE_PROTECTED  0x4
+
 struct waffle_gbm_display {
     struct gbm_device *gbm_device;
     EGLDisplay egl_display;
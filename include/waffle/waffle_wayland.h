@@ -41,7 +41,10 @@ struct wl_display;
 struct wl_egl_window;
 struct wl_shell;
 struct wl_shell_surface;
+struct wl_subsurface;
 struct wl_surface;
+struct xdg_surface;
+struct xdg_toplevel;
 
 struct waffle_wayland_display {
     struct wl_display *wl_display;
@@ -66,6 +69,13 @@ struct waffle_wayland_window {
     struct wl_shell_surface *wl_shell_surface;
     struct wl_egl_window *wl_window;
     EGLSurface egl_surface;
+
+    // Set instead of wl_shell_surface if the compositor supports xdg-shell.
+    struct xdg_surface *xdg_surface;
+    struct xdg_toplevel *xdg_toplevel;
+
+    // Set if the window was created with WAFFLE_WINDOW_PARENT.
+    struct wl_subsurface *wl_subsurface;
 };
 
 #ifdef __cplusplus
@@ -36,9 +36,11 @@ set(html_outputs
     ${html_out_dir}/waffle_dl.3.html
     ${html_out_dir}/waffle_enum.3.html
     ${html_out_dir}/waffle_error.3.html
+    ${html_out_dir}/waffle_fence.3.html
     ${html_out_dir}/waffle_gbm.3.html
     ${html_out_dir}/waffle_get_proc_address.3.html
     ${html_out_dir}/waffle_glx.3.html
+    ${html_out_dir}/waffle_image.3.html
     ${html_out_dir}/waffle_init.3.html
     ${html_out_dir}/waffle_is_extension_in_string.3.html
     ${html_out_dir}/waffle_make_current.3.html
@@ -75,9 +77,11 @@ waffle_add_html(3 waffle_display)
 waffle_add_html(3 waffle_dl)
 waffle_add_html(3 waffle_enum)
 waffle_add_html(3 waffle_error)
+waffle_add_html(3 waffle_fence)
 waffle_add_html(3 waffle_gbm)
 waffle_add_html(3 waffle_get_proc_address)
 waffle_add_html(3 waffle_glx)
+waffle_add_html(3 waffle_image)
 waffle_add_html(3 waffle_init)
 waffle_add_html(3 waffle_is_extension_in_string)
 waffle_add_html(3 waffle_make_current)
@@ -38,9 +38,11 @@ set(man_outputs
     ${man_out_dir}/man3/waffle_dl.3
     ${man_out_dir}/man3/waffle_enum.3
     ${man_out_dir}/man3/waffle_error.3
+    ${man_out_dir}/man3/waffle_fence.3
     ${man_out_dir}/man3/waffle_gbm.3
     ${man_out_dir}/man3/waffle_get_proc_address.3
     ${man_out_dir}/man3/waffle_glx.3
+    ${man_out_dir}/man3/waffle_image.3
     ${man_out_dir}/man3/waffle_init.3
     ${man_out_dir}/man3/waffle_is_extension_in_string.3
     ${man_out_dir}/man3/waffle_make_current.3
@@ -75,9 +77,11 @@ waffle_add_manpage(3 waffle_display)
 waffle_add_manpage(3 waffle_dl)
 waffle_add_manpage(3 waffle_enum)
 waffle_add_manpage(3 waffle_error)
+waffle_add_manpage(3 waffle_fence)
 waffle_add_manpage(3 waffle_gbm)
 waffle_add_manpage(3 waffle_get_proc_address)
 waffle_add_manpage(3 waffle_glx)
+waffle_add_manpage(3 waffle_image)
 waffle_add_manpage(3 waffle_init)
 waffle_add_manpage(3 waffle_is_extension_in_string)
 waffle_add_manpage(3 waffle_make_current)
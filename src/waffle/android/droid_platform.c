@@ -32,6 +32,7 @@
 
 #include "wegl_config.h"
 #include "wegl_context.h"
+#include "wegl_fence.h"
 #include "wegl_util.h"
 
 #include "droid_display.h"
@@ -109,12 +110,14 @@ static const struct wcore_platform_vtbl droid_platform_vtbl = {
     .get_proc_address = wegl_get_proc_address,
     .dl_can_open = droid_dl_can_open,
     .dl_sym = droid_dl_sym,
+    .enumerate_devices = NULL,
 
     .display = {
         .connect = droid_display_connect,
         .destroy = droid_display_disconnect,
         .supports_context_api = wegl_display_supports_context_api,
         .get_native = NULL,
+        .adopt_native = NULL,
     },
 
     .config = {
@@ -125,8 +128,10 @@ static const struct wcore_platform_vtbl droid_platform_vtbl = {
 
     .context = {
         .create = wegl_context_create,
+        .create_no_config = wegl_context_create_no_config,
         .destroy = wegl_context_destroy,
         .get_native = NULL,
+        .get_attrib = wegl_context_get_attrib,
     },
 
     .window = {
@@ -136,5 +141,28 @@ static const struct wcore_platform_vtbl droid_platform_vtbl = {
         .swap_buffers = wegl_window_swap_buffers,
         .resize = droid_window_resize,
         .get_native = NULL,
+        .create_many = NULL,
+        .get_attrib = NULL,
+        .adopt_native = NULL,
+        .export_frame = NULL,
+        .release_frame = NULL,
+        .map_front_buffer = NULL,
+        .unmap_front_buffer = NULL,
+    },
+
+    .image = {
+        .create_from_dmabuf = NULL,
+        .create_from_texture = NULL,
+        .destroy = NULL,
+        .bind_texture = NULL,
+        .export_dmabuf = NULL,
+    },
+
+    .fence = {
+        .create = wegl_fence_create,
+        .destroy = wegl_fence_destroy,
+        .wait = wegl_fence_wait,
+        .server_wait = wegl_fence_server_wait,
+        .export_fd = wegl_fence_export_fd,
     },
 };
@@ -25,7 +25,9 @@
 
 #include "api_priv.h"
 
+#include "wcore_config_attrs.h"
 #include "wcore_context.h"
+#include "wcore_display.h"
 #include "wcore_error.h"
 #include "wcore_platform.h"
 
@@ -57,6 +59,45 @@ waffle_context_create(
     return waffle_context(wc_self);
 }
 
+WAFFLE_API struct waffle_context*
+waffle_context_create_no_config(
+        struct waffle_display *dpy,
+        const int32_t attrib_list[],
+        struct waffle_context *shared_ctx)
+{
+    struct wcore_context *wc_self;
+    struct wcore_display *wc_dpy = wcore_display(dpy);
+    struct wcore_context *wc_shared_ctx = wcore_context(shared_ctx);
+    struct wcore_config_attrs attrs;
+
+    const struct api_object *obj_list[2];
+    int len = 0;
+
+    obj_list[len++] = wc_dpy ? &wc_dpy->api : NULL;
+    if (wc_shared_ctx)
+        obj_list[len++] = &wc_shared_ctx->api;
+
+    if (!api_check_entry(obj_list, len))
+        return NULL;
+
+    if (!wcore_config_attrs_parse_context(attrib_list, &attrs))
+        return NULL;
+
+    if (!api_platform->vtbl->context.create_no_config) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return NULL;
+    }
+
+    wc_self = api_platform->vtbl->context.create_no_config(api_platform,
+                                                           wc_dpy,
+                                                           &attrs,
+                                                           wc_shared_ctx);
+    if (!wc_self)
+        return NULL;
+
+    return waffle_context(wc_self);
+}
+
 WAFFLE_API bool
 waffle_context_destroy(struct waffle_context *self)
 {
@@ -92,3 +133,31 @@ waffle_context_get_native(struct waffle_context *self)
         return NULL;
     }
 }
+
+WAFFLE_API bool
+waffle_context_get_attrib(
+        struct waffle_context *self,
+        int32_t attrib,
+        intptr_t *value)
+{
+    struct wcore_context *wc_self = wcore_context(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!value) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "value is null");
+        return false;
+    }
+
+    if (!api_platform->vtbl->context.get_attrib) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->context.get_attrib(wc_self, attrib, value);
+}
@@ -45,6 +45,31 @@ waffle_display_connect(const char *name)
     return waffle_display(wc_self);
 }
 
+WAFFLE_API struct waffle_display*
+waffle_display_adopt_native(union waffle_native_display *native)
+{
+    struct wcore_display *wc_self;
+
+    if (!api_check_entry(NULL, 0))
+        return NULL;
+
+    if (!native) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "native is null");
+        return NULL;
+    }
+
+    if (!api_platform->vtbl->display.adopt_native) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return NULL;
+    }
+
+    wc_self = api_platform->vtbl->display.adopt_native(api_platform, native);
+    if (!wc_self)
+        return NULL;
+
+    return waffle_display(wc_self);
+}
+
 WAFFLE_API bool
 waffle_display_disconnect(struct waffle_display *self)
 {
@@ -60,6 +85,32 @@ waffle_display_disconnect(struct waffle_display *self)
     return api_platform->vtbl->display.destroy(wc_self);
 }
 
+WAFFLE_API bool
+waffle_enumerate_devices(
+        struct waffle_device_info devices[],
+        int32_t max_devices,
+        int32_t *num_devices)
+{
+    if (!api_check_entry(NULL, 0))
+        return false;
+
+    if (!num_devices || max_devices < 0 || (!devices && max_devices > 0)) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "num_devices is null, or devices does not hold "
+                     "max_devices entries");
+        return false;
+    }
+
+    if (!api_platform->vtbl->enumerate_devices) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    *num_devices = 0;
+    return api_platform->vtbl->enumerate_devices(api_platform, devices,
+                                                 max_devices, num_devices);
+}
+
 WAFFLE_API bool
 waffle_display_supports_context_api(
         struct waffle_display *self,
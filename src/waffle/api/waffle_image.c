@@ -0,0 +1,197 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "api_priv.h"
+
+#include "wcore_context.h"
+#include "wcore_display.h"
+#include "wcore_error.h"
+#include "wcore_image.h"
+#include "wcore_platform.h"
+#include "wcore_tinfo.h"
+
+WAFFLE_API struct waffle_image*
+waffle_image_create_from_dmabuf(
+        struct waffle_display *dpy,
+        const struct waffle_dmabuf *dmabuf)
+{
+    struct wcore_display *wc_dpy = wcore_display(dpy);
+    struct wcore_image *wc_self;
+
+    const struct api_object *obj_list[] = {
+        wc_dpy ? &wc_dpy->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return NULL;
+
+    if (!dmabuf) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "dmabuf is null");
+        return NULL;
+    }
+
+    if (dmabuf->width <= 0 || dmabuf->height <= 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "dmabuf size %dx%d is not positive",
+                     dmabuf->width, dmabuf->height);
+        return NULL;
+    }
+
+    if (dmabuf->num_planes < 1 ||
+        dmabuf->num_planes > WAFFLE_DMABUF_MAX_PLANES) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "dmabuf has %d planes, expected 1 to %d",
+                     dmabuf->num_planes, WAFFLE_DMABUF_MAX_PLANES);
+        return NULL;
+    }
+
+    if (!api_platform->vtbl->image.create_from_dmabuf) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return NULL;
+    }
+
+    wc_self = api_platform->vtbl->image.create_from_dmabuf(wc_dpy, dmabuf);
+    if (!wc_self)
+        return NULL;
+
+    return waffle_image(wc_self);
+}
+
+WAFFLE_API struct waffle_image*
+waffle_image_create_from_texture(
+        struct waffle_context *ctx,
+        uint32_t texture,
+        int32_t width,
+        int32_t height)
+{
+    struct wcore_context *wc_ctx = wcore_context(ctx);
+    struct wcore_image *wc_self;
+
+    const struct api_object *obj_list[] = {
+        wc_ctx ? &wc_ctx->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return NULL;
+
+    if (texture == 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "texture is 0");
+        return NULL;
+    }
+
+    if (width <= 0 || height <= 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "texture size %dx%d is not positive", width, height);
+        return NULL;
+    }
+
+    if (!api_platform->vtbl->image.create_from_texture) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return NULL;
+    }
+
+    wc_self = api_platform->vtbl->image.create_from_texture(wc_ctx, texture,
+                                                            width, height);
+    if (!wc_self)
+        return NULL;
+
+    return waffle_image(wc_self);
+}
+
+WAFFLE_API bool
+waffle_image_destroy(struct waffle_image *self)
+{
+    struct wcore_image *wc_self = wcore_image(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    return api_platform->vtbl->image.destroy(wc_self);
+}
+
+WAFFLE_API bool
+waffle_image_bind_texture(
+        struct waffle_image *self,
+        uint32_t target)
+{
+    struct wcore_image *wc_self = wcore_image(self);
+    struct wcore_context *wc_ctx;
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    wc_ctx = wcore_tinfo_get()->current_context;
+    if (!wc_ctx) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "no context is current");
+        return false;
+    }
+
+    if (wc_ctx->api.display_id != wc_self->api.display_id) {
+        wcore_error(WAFFLE_ERROR_BAD_DISPLAY_MATCH);
+        return false;
+    }
+
+    if (!api_platform->vtbl->image.bind_texture) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->image.bind_texture(wc_self, target);
+}
+
+WAFFLE_API bool
+waffle_image_export_dmabuf(
+        struct waffle_image *self,
+        struct waffle_dmabuf *dmabuf)
+{
+    struct wcore_image *wc_self = wcore_image(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!dmabuf) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "dmabuf is null");
+        return false;
+    }
+
+    if (!api_platform->vtbl->image.export_dmabuf) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->image.export_dmabuf(wc_self, dmabuf);
+}
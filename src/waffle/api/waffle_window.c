@@ -32,6 +32,34 @@
 #include "wcore_error.h"
 #include "wcore_platform.h"
 #include "wcore_window.h"
+#include "wcore_window_attrs.h"
+
+/// Check that the parent, if any, belongs to the config's display, and then
+/// parse @a attrib_list with wcore_window_attrs_parse().
+static bool
+parse_window_attrib_list(struct wcore_config *wc_config,
+                         const intptr_t attrib_list[],
+                         int32_t *out_width,
+                         int32_t *out_height,
+                         intptr_t **filtered)
+{
+    intptr_t parent = 0;
+    bool has_parent;
+
+    has_parent = wcore_attrib_list_get(attrib_list, WAFFLE_WINDOW_PARENT,
+                                       &parent);
+
+    const struct api_object *obj_list[] = {
+        wc_config ? &wc_config->api : NULL,
+        parent ? &wcore_window((struct waffle_window *) parent)->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, has_parent ? 2 : 1))
+        return false;
+
+    return wcore_window_attrs_parse(attrib_list, out_width, out_height,
+                                    filtered);
+}
 
 WAFFLE_API struct waffle_window*
 waffle_window_create2(
@@ -41,86 +69,118 @@ waffle_window_create2(
     struct wcore_window *wc_self = NULL;
     struct wcore_config *wc_config = wcore_config(config);
     intptr_t *attrib_list_filtered = NULL;
-    intptr_t width = 1, height = 1;
-    bool need_size = true;
-    intptr_t fullscreen = WAFFLE_DONT_CARE;
+    int32_t width, height;
 
-    const struct api_object *obj_list[] = {
-        wc_config ? &wc_config->api : NULL,
-    };
+    if (!parse_window_attrib_list(wc_config, attrib_list, &width, &height,
+                                  &attrib_list_filtered))
+        return NULL;
+
+    wc_self = api_platform->vtbl->window.create(api_platform,
+                                                wc_config,
+                                                width,
+                                                height,
+                                                attrib_list_filtered);
+    free(attrib_list_filtered);
 
-    if (!api_check_entry(obj_list, 1)) {
-        goto done;
+    if (!wc_self) {
+        return NULL;
     }
 
-    attrib_list_filtered = wcore_attrib_list_copy(attrib_list);
+    return waffle_window(wc_self);
+}
 
-    wcore_attrib_list_pop(attrib_list_filtered,
-                          WAFFLE_WINDOW_FULLSCREEN, &fullscreen);
-    if (fullscreen == WAFFLE_DONT_CARE)
-        fullscreen = 0; // default
+WAFFLE_API bool
+waffle_window_create_many(
+        struct waffle_config *config,
+        const intptr_t attrib_list[],
+        int32_t count,
+        struct waffle_window *windows[])
+{
+    struct wcore_config *wc_config = wcore_config(config);
+    struct wcore_window **wc_windows = (struct wcore_window **) windows;
+    const struct wcore_window_vtbl *vtbl;
+    intptr_t *attrib_list_filtered = NULL;
+    int32_t width, height;
+    int32_t i = 0;
+    bool ok = true;
 
-    if (fullscreen == 1) {
-        need_size = false;
-    } else if (fullscreen != 0) {
-        // Same error message as in wcore_config_attrs.c.
-        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
-                     "WAFFLE_WINDOW_FULLSCREEN has bad value 0x%x. "
-                     "Must be true(1), false(0), or WAFFLE_DONT_CARE(-1)",
-                     fullscreen);
-        goto done;
-    }
+    if (!parse_window_attrib_list(wc_config, attrib_list, &width, &height,
+                                  &attrib_list_filtered))
+        return false;
 
-    if (!wcore_attrib_list_pop(attrib_list_filtered,
-                               WAFFLE_WINDOW_WIDTH, &width) && need_size) {
-        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
-                     "required attribute WAFFLE_WINDOW_WIDTH is missing");
-        goto done;
+    if (count <= 0 || !windows) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "count must be positive and windows non-null");
+        free(attrib_list_filtered);
+        return false;
     }
 
-    if (!wcore_attrib_list_pop(attrib_list_filtered,
-                               WAFFLE_WINDOW_HEIGHT, &height) && need_size) {
-        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
-                     "required attribute WAFFLE_WINDOW_HEIGHT is missing");
-        goto done;
-    }
+    vtbl = &api_platform->vtbl->window;
 
-    if (width <= 0) {
-        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
-                     "WAFFLE_WINDOW_WIDTH is not positive");
-        goto done;
-    } else if (width > INT32_MAX) {
-        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
-                     "WAFFLE_WINDOW_WIDTH is greater than INT32_MAX");
-        goto done;
+    // A struct waffle_window* is the address of its wcore_window, so the
+    // platform may fill the caller's array directly.
+    if (vtbl->create_many) {
+        ok = vtbl->create_many(api_platform, wc_config, width, height,
+                               attrib_list_filtered, count, wc_windows);
+    }
+    else {
+        for (i = 0; i < count; ++i) {
+            wc_windows[i] = vtbl->create(api_platform, wc_config,
+                                         width, height,
+                                         attrib_list_filtered);
+            if (!wc_windows[i]) {
+                ok = false;
+                break;
+            }
+        }
+
+        if (!ok) {
+            while (i-- > 0)
+                vtbl->destroy(wc_windows[i]);
+        }
     }
 
-    if (height <= 0) {
-        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
-                     "WAFFLE_WINDOW_HEIGHT is not positive");
-        goto done;
-    } else if (height > INT32_MAX) {
-        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
-                     "WAFFLE_WINDOW_HEIGHT is greater than INT32_MAX");
-        goto done;
+    free(attrib_list_filtered);
+
+    if (!ok) {
+        for (i = 0; i < count; ++i)
+            windows[i] = NULL;
     }
 
-    if (fullscreen)
-        width = height = -1;
+    return ok;
+}
 
-    wc_self = api_platform->vtbl->window.create(api_platform,
-                                                wc_config,
-                                                (int32_t) width,
-                                                (int32_t) height,
-                                                attrib_list_filtered);
+WAFFLE_API struct waffle_window*
+waffle_window_adopt_native(
+        struct waffle_config *config,
+        union waffle_native_window *native)
+{
+    struct wcore_window *wc_self;
+    struct wcore_config *wc_config = wcore_config(config);
 
-done:
-    free(attrib_list_filtered);
+    const struct api_object *obj_list[] = {
+        wc_config ? &wc_config->api : NULL,
+    };
 
-    if (!wc_self) {
+    if (!api_check_entry(obj_list, 1))
+        return NULL;
+
+    if (!native) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "native is null");
         return NULL;
     }
 
+    if (!api_platform->vtbl->window.adopt_native) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return NULL;
+    }
+
+    wc_self = api_platform->vtbl->window.adopt_native(api_platform,
+                                                      wc_config,
+                                                      native);
+    if (!wc_self)
+        return NULL;
+
     return waffle_window(wc_self);
 }
 
@@ -207,6 +267,128 @@ waffle_window_swap_buffers(struct waffle_window *self)
     return api_platform->vtbl->window.swap_buffers(wc_self);
 }
 
+WAFFLE_API bool
+waffle_window_get_attrib(
+        struct waffle_window *self,
+        int32_t attrib,
+        intptr_t *value)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!value) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "value is null");
+        return false;
+    }
+
+    if (!api_platform->vtbl->window.get_attrib) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.get_attrib(wc_self, attrib, value);
+}
+
+WAFFLE_API bool
+waffle_window_export_frame(
+        struct waffle_window *self,
+        struct waffle_dmabuf *frame)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!frame) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "frame is null");
+        return false;
+    }
+
+    if (!api_platform->vtbl->window.export_frame) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.export_frame(wc_self, frame);
+}
+
+WAFFLE_API bool
+waffle_window_release_frame(struct waffle_window *self)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!api_platform->vtbl->window.release_frame) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.release_frame(wc_self);
+}
+
+WAFFLE_API bool
+waffle_window_map_front_buffer(
+        struct waffle_window *self,
+        struct waffle_mapped_frame *frame)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!frame) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "frame is null");
+        return false;
+    }
+
+    if (!api_platform->vtbl->window.map_front_buffer) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.map_front_buffer(wc_self, frame);
+}
+
+WAFFLE_API bool
+waffle_window_unmap_front_buffer(struct waffle_window *self)
+{
+    struct wcore_window *wc_self = wcore_window(self);
+
+    const struct api_object *obj_list[] = {
+        wc_self ? &wc_self->api : NULL,
+    };
+
+    if (!api_check_entry(obj_list, 1))
+        return false;
+
+    if (!api_platform->vtbl->window.unmap_front_buffer) {
+        wcore_error(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        return false;
+    }
+
+    return api_platform->vtbl->window.unmap_front_buffer(wc_self);
+}
+
 WAFFLE_API union waffle_native_window*
 waffle_window_get_native(struct waffle_window *self)
 {
@@ -88,6 +88,24 @@ cgl_config_check_attrs(const struct cgl_platform *plat,
         return false;
     }
 
+    if (attrs->context_no_error) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "CGL does not support no-error contexts");
+        return false;
+    }
+
+    if (attrs->context_priority != WAFFLE_CONTEXT_PRIORITY_MEDIUM) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "CGL does not support context priorities");
+        return false;
+    }
+
+    if (attrs->context_release_behavior != WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "CGL does not support context release behaviors");
+        return false;
+    }
+
     // Emulate EGL_KHR_create_context, which allows the implementation to
     // return a context of the latest supported flavor that is
     // backwards-compatibile with the requested flavor.
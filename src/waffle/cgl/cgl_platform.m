@@ -162,12 +162,14 @@ static const struct wcore_platform_vtbl cgl_platform_vtbl = {
     .get_proc_address = cgl_get_proc_address,
     .dl_can_open = cgl_dl_can_open,
     .dl_sym = cgl_dl_sym,
+    .enumerate_devices = NULL,
 
     .display = {
         .connect = cgl_display_connect,
         .destroy = cgl_display_destroy,
         .supports_context_api = cgl_display_supports_context_api,
         .get_native = NULL,
+        .adopt_native = NULL,
     },
 
     .config = {
@@ -178,8 +180,10 @@ static const struct wcore_platform_vtbl cgl_platform_vtbl = {
 
     .context = {
         .create = cgl_context_create,
+        .create_no_config = NULL,
         .destroy = cgl_context_destroy,
         .get_native = NULL,
+        .get_attrib = NULL,
     },
 
     .window = {
@@ -189,5 +193,28 @@ static const struct wcore_platform_vtbl cgl_platform_vtbl = {
         .resize = cgl_window_resize,
         .swap_buffers = cgl_window_swap_buffers,
         .get_native = NULL,
+        .create_many = NULL,
+        .get_attrib = NULL,
+        .adopt_native = NULL,
+        .export_frame = NULL,
+        .release_frame = NULL,
+        .map_front_buffer = NULL,
+        .unmap_front_buffer = NULL,
+    },
+
+    .image = {
+        .create_from_dmabuf = NULL,
+        .create_from_texture = NULL,
+        .destroy = NULL,
+        .bind_texture = NULL,
+        .export_dmabuf = NULL,
+    },
+
+    .fence = {
+        .create = NULL,
+        .destroy = NULL,
+        .wait = NULL,
+        .server_wait = NULL,
+        .export_fd = NULL,
     },
 };
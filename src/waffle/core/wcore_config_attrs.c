@@ -55,6 +55,9 @@ check_keys(const int32_t attrib_list[])
             case WAFFLE_CONTEXT_FORWARD_COMPATIBLE:
             case WAFFLE_CONTEXT_DEBUG:
             case WAFFLE_CONTEXT_ROBUST_ACCESS:
+            case WAFFLE_CONTEXT_NO_ERROR:
+            case WAFFLE_CONTEXT_PRIORITY:
+            case WAFFLE_CONTEXT_RELEASE_BEHAVIOR:
             case WAFFLE_RED_SIZE:
             case WAFFLE_GREEN_SIZE:
             case WAFFLE_BLUE_SIZE:
@@ -282,6 +285,60 @@ parse_context_forward_compatible(struct wcore_config_attrs *attrs,
     return true;
 }
 
+static bool
+parse_context_priority(struct wcore_config_attrs *attrs,
+                       const int32_t attrib_list[])
+{
+    wcore_attrib_list32_get_with_default(attrib_list,
+                                         WAFFLE_CONTEXT_PRIORITY,
+                                         &attrs->context_priority,
+                                         WAFFLE_CONTEXT_PRIORITY_MEDIUM);
+
+    switch (attrs->context_priority) {
+        case WAFFLE_DONT_CARE:
+            attrs->context_priority = WAFFLE_CONTEXT_PRIORITY_MEDIUM;
+            break;
+        case WAFFLE_CONTEXT_PRIORITY_LOW:
+        case WAFFLE_CONTEXT_PRIORITY_MEDIUM:
+        case WAFFLE_CONTEXT_PRIORITY_HIGH:
+        case WAFFLE_CONTEXT_PRIORITY_REALTIME:
+            break;
+        default:
+            wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                         "WAFFLE_CONTEXT_PRIORITY has bad value %#x",
+                         attrs->context_priority);
+            return false;
+    }
+
+    return true;
+}
+
+static bool
+parse_context_release_behavior(struct wcore_config_attrs *attrs,
+                               const int32_t attrib_list[])
+{
+    wcore_attrib_list32_get_with_default(attrib_list,
+                                         WAFFLE_CONTEXT_RELEASE_BEHAVIOR,
+                                         &attrs->context_release_behavior,
+                                         WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH);
+
+    switch (attrs->context_release_behavior) {
+        case WAFFLE_DONT_CARE:
+            attrs->context_release_behavior = WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH;
+            break;
+        case WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH:
+        case WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE:
+            break;
+        default:
+            wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                         "WAFFLE_CONTEXT_RELEASE_BEHAVIOR has bad value %#x",
+                         attrs->context_release_behavior);
+            return false;
+    }
+
+    return true;
+}
+
 static bool
 set_misc_defaults(struct wcore_config_attrs *attrs)
 {
@@ -293,6 +350,7 @@ set_misc_defaults(struct wcore_config_attrs *attrs)
 
     attrs->context_debug        = false;
     attrs->context_robust       = false;
+    attrs->context_no_error     = false;
 
     attrs->rgba_size            = 0;
     attrs->red_size             = 0;
@@ -356,6 +414,8 @@ parse_misc(struct wcore_config_attrs *attrs,
             case WAFFLE_CONTEXT_MINOR_VERSION:
             case WAFFLE_CONTEXT_PROFILE:
             case WAFFLE_CONTEXT_FORWARD_COMPATIBLE:
+            case WAFFLE_CONTEXT_PRIORITY:
+            case WAFFLE_CONTEXT_RELEASE_BEHAVIOR:
                 // These keys have already been parsed.
                 break;
 
@@ -369,6 +429,7 @@ parse_misc(struct wcore_config_attrs *attrs,
 
             CASE_BOOL(WAFFLE_CONTEXT_DEBUG, context_debug, false);
             CASE_BOOL(WAFFLE_CONTEXT_ROBUST_ACCESS, context_robust, false);
+            CASE_BOOL(WAFFLE_CONTEXT_NO_ERROR, context_no_error, false);
             CASE_BOOL(WAFFLE_SAMPLE_BUFFERS, sample_buffers, DEFAULT_SAMPLE_BUFFERS);
             CASE_BOOL(WAFFLE_DOUBLE_BUFFERED, double_buffered, DEFAULT_DOUBLE_BUFFERED);
             CASE_BOOL(WAFFLE_ACCUM_BUFFER, accum_buffer, DEFAULT_ACCUM_BUFFER);
@@ -414,6 +475,16 @@ check_final(struct wcore_config_attrs *attrs)
         return false;
     }
 
+    // KHR_no_error forbids combining a no-error context with a debug or
+    // robust access one.
+    if (attrs->context_no_error
+        && (attrs->context_debug || attrs->context_robust)) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "%s", "WAFFLE_CONTEXT_NO_ERROR must be false for a "
+                     "debug or robust access context");
+        return false;
+    }
+
     return true;
 }
 
@@ -445,6 +516,12 @@ wcore_config_attrs_parse(
     if (!parse_context_forward_compatible(attrs, waffle_attrib_list))
         return false;
 
+    if (!parse_context_priority(attrs, waffle_attrib_list))
+        return false;
+
+    if (!parse_context_release_behavior(attrs, waffle_attrib_list))
+        return false;
+
     if (!set_misc_defaults(attrs))
         return false;
 
@@ -457,6 +534,48 @@ wcore_config_attrs_parse(
     return true;
 }
 
+// Reject the attributes that describe a framebuffer rather than a context.
+static bool
+check_context_keys(const int32_t attrib_list[])
+{
+    if (!attrib_list)
+        return true;
+
+    for (int i = 0; attrib_list[i]; i += 2) {
+        switch (attrib_list[i]) {
+            case WAFFLE_CONTEXT_API:
+            case WAFFLE_CONTEXT_MAJOR_VERSION:
+            case WAFFLE_CONTEXT_MINOR_VERSION:
+            case WAFFLE_CONTEXT_PROFILE:
+            case WAFFLE_CONTEXT_FORWARD_COMPATIBLE:
+            case WAFFLE_CONTEXT_DEBUG:
+            case WAFFLE_CONTEXT_ROBUST_ACCESS:
+            case WAFFLE_CONTEXT_NO_ERROR:
+            case WAFFLE_CONTEXT_PRIORITY:
+            case WAFFLE_CONTEXT_RELEASE_BEHAVIOR:
+                break;
+            default:
+                wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                             "attribute %#x at attrib_list[%d] is not a "
+                             "context attribute", attrib_list[i], i);
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+wcore_config_attrs_parse_context(
+      const int32_t waffle_attrib_list[],
+      struct wcore_config_attrs *attrs)
+{
+    if (!check_context_keys(waffle_attrib_list))
+        return false;
+
+    return wcore_config_attrs_parse(waffle_attrib_list, attrs);
+}
+
 bool
 wcore_config_attrs_version_eq(
       const struct wcore_config_attrs *attrs,
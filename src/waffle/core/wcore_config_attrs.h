@@ -55,6 +55,9 @@ struct wcore_config_attrs {
     bool context_forward_compatible;
     bool context_debug;
     bool context_robust;
+    bool context_no_error;
+    int32_t context_priority;
+    int32_t context_release_behavior;
     bool double_buffered;
     bool sample_buffers;
     bool accum_buffer;
@@ -65,6 +68,16 @@ wcore_config_attrs_parse(
       const int32_t waffle_attrib_list[],
       struct wcore_config_attrs *attrs);
 
+/// @brief Parse the attribute list received by
+/// waffle_context_create_no_config().
+///
+/// Like wcore_config_attrs_parse(), but reject the attributes that describe
+/// a framebuffer rather than a context.
+bool
+wcore_config_attrs_parse_context(
+      const int32_t waffle_attrib_list[],
+      struct wcore_config_attrs *attrs);
+
 bool
 wcore_config_attrs_version_eq(
       const struct wcore_config_attrs *attrs,
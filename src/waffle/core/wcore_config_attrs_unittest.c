@@ -51,6 +51,8 @@ setup(void **state) {
         .context_profile        = WAFFLE_NONE,
         .context_debug          = false,
         .context_forward_compatible = false,
+        .context_priority       = WAFFLE_CONTEXT_PRIORITY_MEDIUM,
+        .context_release_behavior = WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH,
 
         .rgb_size               = 0,
         .rgba_size              = 0,
@@ -1089,6 +1091,193 @@ test_wcore_config_attrs_debug_gles3(void **state) {
     assert_memory_equal(&ts->actual_attrs, &ts->expect_attrs, sizeof(ts->expect_attrs));
 }
 
+static void
+test_wcore_config_attrs_no_error_gles2(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL_ES2,
+        WAFFLE_CONTEXT_NO_ERROR,                true,
+        0,
+    };
+
+    ts->expect_attrs.context_api = WAFFLE_CONTEXT_OPENGL_ES2;
+    ts->expect_attrs.context_major_version = 2;
+    ts->expect_attrs.context_no_error = true;
+
+    assert_true(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_NO_ERROR);
+    assert_memory_equal(&ts->actual_attrs, &ts->expect_attrs, sizeof(ts->expect_attrs));
+}
+
+static void
+test_wcore_config_attrs_no_error_and_debug(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_CONTEXT_NO_ERROR,                true,
+        WAFFLE_CONTEXT_DEBUG,                   true,
+        0,
+    };
+
+    assert_false(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
+static void
+test_wcore_config_attrs_no_error_and_robust(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_CONTEXT_NO_ERROR,                true,
+        WAFFLE_CONTEXT_ROBUST_ACCESS,           true,
+        0,
+    };
+
+    assert_false(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
+static void
+test_wcore_config_attrs_priority_high(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_CONTEXT_PRIORITY,                WAFFLE_CONTEXT_PRIORITY_HIGH,
+        0,
+    };
+
+    ts->expect_attrs.context_priority = WAFFLE_CONTEXT_PRIORITY_HIGH;
+
+    assert_true(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_NO_ERROR);
+    assert_memory_equal(&ts->actual_attrs, &ts->expect_attrs, sizeof(ts->expect_attrs));
+}
+
+static void
+test_wcore_config_attrs_priority_dont_care(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_CONTEXT_PRIORITY,                WAFFLE_DONT_CARE,
+        0,
+    };
+
+    assert_true(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_NO_ERROR);
+    assert_memory_equal(&ts->actual_attrs, &ts->expect_attrs, sizeof(ts->expect_attrs));
+}
+
+static void
+test_wcore_config_attrs_priority_bad_value(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_CONTEXT_PRIORITY,                WAFFLE_CONTEXT_OPENGL,
+        0,
+    };
+
+    assert_false(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
+static void
+test_wcore_config_attrs_release_behavior_none(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL_ES2,
+        WAFFLE_CONTEXT_RELEASE_BEHAVIOR,        WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE,
+        0,
+    };
+
+    ts->expect_attrs.context_api = WAFFLE_CONTEXT_OPENGL_ES2;
+    ts->expect_attrs.context_major_version = 2;
+    ts->expect_attrs.context_release_behavior = WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE;
+
+    assert_true(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_NO_ERROR);
+    assert_memory_equal(&ts->actual_attrs, &ts->expect_attrs, sizeof(ts->expect_attrs));
+}
+
+static void
+test_wcore_config_attrs_release_behavior_bad_value(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_CONTEXT_RELEASE_BEHAVIOR,        true,
+        0,
+    };
+
+    assert_false(wcore_config_attrs_parse(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
+static void
+test_wcore_config_attrs_parse_context(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_CONTEXT_MAJOR_VERSION,           3,
+        WAFFLE_CONTEXT_MINOR_VERSION,           2,
+        WAFFLE_CONTEXT_PROFILE,                 WAFFLE_CONTEXT_CORE_PROFILE,
+        WAFFLE_CONTEXT_DEBUG,                   true,
+        WAFFLE_CONTEXT_PRIORITY,                WAFFLE_CONTEXT_PRIORITY_LOW,
+        0,
+    };
+
+    assert_true(wcore_config_attrs_parse_context(attrib_list, &ts->actual_attrs));
+    assert_int_equal(ts->actual_attrs.context_major_version, 3);
+    assert_int_equal(ts->actual_attrs.context_minor_version, 2);
+    assert_int_equal(ts->actual_attrs.context_profile, WAFFLE_CONTEXT_CORE_PROFILE);
+    assert_true(ts->actual_attrs.context_debug);
+    assert_int_equal(ts->actual_attrs.context_priority, WAFFLE_CONTEXT_PRIORITY_LOW);
+}
+
+static void
+test_wcore_config_attrs_parse_context_rejects_red_size(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_RED_SIZE,                        8,
+        0,
+    };
+
+    assert_false(wcore_config_attrs_parse_context(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
+static void
+test_wcore_config_attrs_parse_context_rejects_double_buffered(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    const int32_t attrib_list[] = {
+        WAFFLE_CONTEXT_API,                     WAFFLE_CONTEXT_OPENGL_ES2,
+        WAFFLE_DOUBLE_BUFFERED,                 false,
+        0,
+    };
+
+    assert_false(wcore_config_attrs_parse_context(attrib_list, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
+static void
+test_wcore_config_attrs_parse_context_null_attrib_list(void **state) {
+    struct test_state_wcore_config_attrs *ts = *state;
+
+    // The context API is still required.
+    assert_false(wcore_config_attrs_parse_context(NULL, &ts->actual_attrs));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
 int
 main(void) {
     const struct CMUnitTest tests[] = {
@@ -1151,6 +1340,18 @@ main(void) {
         unit_test_make(test_wcore_config_attrs_debug_gles1),
         unit_test_make(test_wcore_config_attrs_debug_gles2),
         unit_test_make(test_wcore_config_attrs_debug_gles3),
+        unit_test_make(test_wcore_config_attrs_no_error_gles2),
+        unit_test_make(test_wcore_config_attrs_no_error_and_debug),
+        unit_test_make(test_wcore_config_attrs_no_error_and_robust),
+        unit_test_make(test_wcore_config_attrs_priority_high),
+        unit_test_make(test_wcore_config_attrs_priority_dont_care),
+        unit_test_make(test_wcore_config_attrs_priority_bad_value),
+        unit_test_make(test_wcore_config_attrs_release_behavior_none),
+        unit_test_make(test_wcore_config_attrs_release_behavior_bad_value),
+        unit_test_make(test_wcore_config_attrs_parse_context),
+        unit_test_make(test_wcore_config_attrs_parse_context_rejects_red_size),
+        unit_test_make(test_wcore_config_attrs_parse_context_rejects_double_buffered),
+        unit_test_make(test_wcore_config_attrs_parse_context_null_attrib_list),
 
         #undef unit_test_make
     };
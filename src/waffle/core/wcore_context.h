@@ -55,19 +55,30 @@ wcore_context(struct waffle_context *ctx) {
 }
 
 static inline bool
-wcore_context_init(struct wcore_context *self,
-                   struct wcore_config *config)
+wcore_context_init_no_config(struct wcore_context *self,
+                             struct wcore_display *display,
+                             const struct wcore_config_attrs *attrs)
 {
     assert(self);
-    assert(config);
+    assert(display);
+    assert(attrs);
 
-    self->api.display_id = config->display->api.display_id;
-    self->context_api = config->attrs.context_api;
-    self->display = config->display;
+    self->api.display_id = display->api.display_id;
+    self->context_api = attrs->context_api;
+    self->display = display;
 
     return true;
 }
 
+static inline bool
+wcore_context_init(struct wcore_context *self,
+                   struct wcore_config *config)
+{
+    assert(config);
+    return wcore_context_init_no_config(self, config->display,
+                                        &config->attrs);
+}
+
 static inline bool
 wcore_context_teardown(struct wcore_context *self)
 {
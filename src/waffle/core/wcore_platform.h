@@ -34,8 +34,11 @@ struct wcore_config;
 struct wcore_config_attrs;
 struct wcore_context;
 struct wcore_display;
+struct wcore_fence;
+struct wcore_image;
 struct wcore_platform;
 struct wcore_window;
+struct waffle_device_info;
 
 struct wcore_platform_vtbl {
     bool
@@ -64,6 +67,18 @@ struct wcore_platform_vtbl {
             int32_t waffle_dl,
             const char *symbol);
 
+    /// @brief List the GPUs that the platform can use.
+    ///
+    /// Fill at most @a max_devices entries and count all devices.
+    ///
+    /// May be null.
+    bool
+    (*enumerate_devices)(
+            struct wcore_platform *self,
+            struct waffle_device_info devices[],
+            int32_t max_devices,
+            int32_t *num_devices);
+
     struct wcore_display_vtbl {
         struct wcore_display*
         (*connect)(struct wcore_platform *platform,
@@ -80,6 +95,16 @@ struct wcore_platform_vtbl {
         /// May be null.
         union waffle_native_display*
         (*get_native)(struct wcore_display *display);
+
+        /// @brief Wrap an application's native display.
+        ///
+        /// The result must not open a new connection, and destroying it must
+        /// not close the native display.
+        ///
+        /// May be null.
+        struct wcore_display*
+        (*adopt_native)(struct wcore_platform *platform,
+                        union waffle_native_display *native);
     } display;
 
     struct wcore_config_vtbl {
@@ -102,12 +127,32 @@ struct wcore_platform_vtbl {
                   struct wcore_config *config,
                   struct wcore_context *share_ctx);
 
+        /// @brief Create a context that is compatible with any config of
+        /// the display.
+        ///
+        /// Only the context attributes of @a attrs are meaningful.
+        ///
+        /// May be null.
+        struct wcore_context*
+        (*create_no_config)(struct wcore_platform *platform,
+                            struct wcore_display *display,
+                            const struct wcore_config_attrs *attrs,
+                            struct wcore_context *share_ctx);
+
         bool
         (*destroy)(struct wcore_context *ctx);
 
         /// May be null.
         union waffle_native_context*
         (*get_native)(struct wcore_context *ctx);
+
+        /// @brief Query a context attribute, such as WAFFLE_CONTEXT_PRIORITY.
+        ///
+        /// May be null.
+        bool
+        (*get_attrib)(struct wcore_context *ctx,
+                      int32_t attrib,
+                      intptr_t *value);
     } context;
 
     struct wcore_window_vtbl {
@@ -117,6 +162,21 @@ struct wcore_platform_vtbl {
                   int32_t width,
                   int32_t height,
                   const intptr_t attrib_list[]);
+
+        /// @brief Create @a count windows that share the arguments of create().
+        ///
+        /// On failure, no window is left behind.
+        ///
+        /// May be null, in which case create() is called for each window.
+        bool
+        (*create_many)(struct wcore_platform *platform,
+                       struct wcore_config *config,
+                       int32_t width,
+                       int32_t height,
+                       const intptr_t attrib_list[],
+                       int32_t count,
+                       struct wcore_window *windows[]);
+
         bool
         (*destroy)(struct wcore_window *window);
 
@@ -134,7 +194,117 @@ struct wcore_platform_vtbl {
         /// May be null.
         union waffle_native_window*
         (*get_native)(struct wcore_window *window);
+
+        /// @brief Query a window attribute, such as
+        /// WAFFLE_WINDOW_BYPASS_COMPOSITOR.
+        ///
+        /// May be null.
+        bool
+        (*get_attrib)(struct wcore_window *window,
+                      int32_t attrib,
+                      intptr_t *value);
+
+        /// @brief Export the last presented buffer as dma-bufs.
+        ///
+        /// The caller owns the returned fds.
+        ///
+        /// May be null.
+        bool
+        (*export_frame)(struct wcore_window *window,
+                        struct waffle_dmabuf *frame);
+
+        /// @brief Release the oldest frame held by export_frame.
+        ///
+        /// Null if and only if export_frame is.
+        bool
+        (*release_frame)(struct wcore_window *window);
+
+        /// @brief Map the last presented buffer for reading.
+        ///
+        /// May be null. If non-null, then unmap_front_buffer is too.
+        bool
+        (*map_front_buffer)(struct wcore_window *window,
+                            struct waffle_mapped_frame *frame);
+
+        /// Succeed if nothing is mapped.
+        bool
+        (*unmap_front_buffer)(struct wcore_window *window);
+
+        /// @brief Wrap an application's native window or surface.
+        ///
+        /// Only the rendering surface is created. Destroying the result must
+        /// not destroy the native window.
+        ///
+        /// May be null.
+        struct wcore_window*
+        (*adopt_native)(struct wcore_platform *platform,
+                        struct wcore_config *config,
+                        union waffle_native_window *native);
     } window;
+
+    struct wcore_image_vtbl {
+        /// May be null.
+        struct wcore_image*
+        (*create_from_dmabuf)(struct wcore_display *display,
+                              const struct waffle_dmabuf *dmabuf);
+
+        /// May be null.
+        struct wcore_image*
+        (*create_from_texture)(struct wcore_context *ctx,
+                               uint32_t texture,
+                               int32_t width,
+                               int32_t height);
+
+        /// May be null if the platform has no image constructor.
+        bool
+        (*destroy)(struct wcore_image *image);
+
+        /// @brief Bind the image to the texture bound to @a target in the
+        /// current context.
+        ///
+        /// May be null.
+        bool
+        (*bind_texture)(struct wcore_image *image,
+                        uint32_t target);
+
+        /// @brief Export the image as dma-bufs. The caller owns the fds.
+        ///
+        /// May be null.
+        bool
+        (*export_dmabuf)(struct wcore_image *image,
+                         struct waffle_dmabuf *dmabuf);
+    } image;
+
+    struct wcore_fence_vtbl {
+        /// @brief Create a fence in the command stream of @a ctx, which is
+        /// current.
+        ///
+        /// May be null.
+        struct wcore_fence*
+        (*create)(struct wcore_context *ctx);
+
+        /// May be null if the platform has no fence constructor.
+        bool
+        (*destroy)(struct wcore_fence *fence);
+
+        /// May be null if the platform has no fence constructor.
+        bool
+        (*wait)(struct wcore_fence *fence,
+                uint64_t timeout_ns,
+                bool *signaled);
+
+        /// @brief Make the current context wait for the fence.
+        ///
+        /// May be null.
+        bool
+        (*server_wait)(struct wcore_fence *fence);
+
+        /// @brief Export the fence as a sync file. The caller owns the fd.
+        ///
+        /// May be null.
+        bool
+        (*export_fd)(struct wcore_fence *fence, int *fd);
+    } fence;
 };
 
 struct wcore_platform {
@@ -116,6 +116,15 @@ wcore_enum_to_string(int32_t e)
         CASE(WAFFLE_CONTEXT_FORWARD_COMPATIBLE);
         CASE(WAFFLE_CONTEXT_DEBUG);
         CASE(WAFFLE_CONTEXT_ROBUST_ACCESS);
+        CASE(WAFFLE_CONTEXT_NO_ERROR);
+        CASE(WAFFLE_CONTEXT_PRIORITY);
+        CASE(WAFFLE_CONTEXT_PRIORITY_LOW);
+        CASE(WAFFLE_CONTEXT_PRIORITY_MEDIUM);
+        CASE(WAFFLE_CONTEXT_PRIORITY_HIGH);
+        CASE(WAFFLE_CONTEXT_PRIORITY_REALTIME);
+        CASE(WAFFLE_CONTEXT_RELEASE_BEHAVIOR);
+        CASE(WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH);
+        CASE(WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE);
         CASE(WAFFLE_RED_SIZE);
         CASE(WAFFLE_GREEN_SIZE);
         CASE(WAFFLE_BLUE_SIZE);
@@ -133,6 +142,14 @@ wcore_enum_to_string(int32_t e)
         CASE(WAFFLE_WINDOW_WIDTH);
         CASE(WAFFLE_WINDOW_HEIGHT);
         CASE(WAFFLE_WINDOW_FULLSCREEN);
+        CASE(WAFFLE_WINDOW_RENDER_WIDTH);
+        CASE(WAFFLE_WINDOW_RENDER_HEIGHT);
+        CASE(WAFFLE_WINDOW_PARENT);
+        CASE(WAFFLE_WINDOW_BYPASS_COMPOSITOR);
+        CASE(WAFFLE_WINDOW_GBM_MODIFIERS);
+        CASE(WAFFLE_WINDOW_GBM_USAGE);
+        CASE(WAFFLE_WINDOW_GBM_MODIFIER);
+        CASE(WAFFLE_WINDOW_BUFFER_COUNT);
 
         default: return NULL;
 
@@ -0,0 +1,204 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include "wcore_attrib_list.h"
+#include "wcore_error.h"
+#include "wcore_window_attrs.h"
+
+// From waffle_gbm.h, which requires EGL.
+#define WCORE_GBM_USAGE_SCANOUT     0x1
+#define WCORE_GBM_USAGE_LINEAR      0x2
+#define WCORE_GBM_USAGE_PROTECTED   0x4
+
+// From drm_fourcc.h.
+#define WCORE_DRM_FORMAT_MOD_INVALID 0x00ffffffffffffffULL
+
+bool
+wcore_window_attrs_parse(
+      const intptr_t attrib_list[],
+      int32_t *out_width,
+      int32_t *out_height,
+      intptr_t **filtered)
+{
+    intptr_t *attrib_list_filtered = NULL;
+    intptr_t width = 1, height = 1;
+    bool need_size = true;
+    intptr_t fullscreen = WAFFLE_DONT_CARE;
+    intptr_t render_width = 0, render_height = 0;
+    bool has_render_width, has_render_height;
+    intptr_t parent = 0;
+    intptr_t usage = 0;
+    intptr_t modifiers_handle = 0;
+    const uint64_t *modifiers;
+    intptr_t buffer_count;
+
+    attrib_list_filtered = wcore_attrib_list_copy(attrib_list);
+    if (!attrib_list_filtered)
+        return false;
+
+    wcore_attrib_list_pop(attrib_list_filtered,
+                          WAFFLE_WINDOW_FULLSCREEN, &fullscreen);
+    if (fullscreen == WAFFLE_DONT_CARE)
+        fullscreen = 0; // default
+
+    if (fullscreen == 1) {
+        need_size = false;
+    } else if (fullscreen != 0) {
+        // Same error message as in wcore_config_attrs.c.
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_FULLSCREEN has bad value 0x%x. "
+                     "Must be true(1), false(0), or WAFFLE_DONT_CARE(-1)",
+                     fullscreen);
+        goto error;
+    }
+
+    if (!wcore_attrib_list_pop(attrib_list_filtered,
+                               WAFFLE_WINDOW_WIDTH, &width) && need_size) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "required attribute WAFFLE_WINDOW_WIDTH is missing");
+        goto error;
+    }
+
+    if (!wcore_attrib_list_pop(attrib_list_filtered,
+                               WAFFLE_WINDOW_HEIGHT, &height) && need_size) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "required attribute WAFFLE_WINDOW_HEIGHT is missing");
+        goto error;
+    }
+
+    if (width <= 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_WIDTH is not positive");
+        goto error;
+    } else if (width > INT32_MAX) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_WIDTH is greater than INT32_MAX");
+        goto error;
+    }
+
+    if (height <= 0) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_HEIGHT is not positive");
+        goto error;
+    } else if (height > INT32_MAX) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_HEIGHT is greater than INT32_MAX");
+        goto error;
+    }
+
+    has_render_width = wcore_attrib_list_get(attrib_list_filtered,
+                                             WAFFLE_WINDOW_RENDER_WIDTH,
+                                             &render_width);
+    has_render_height = wcore_attrib_list_get(attrib_list_filtered,
+                                              WAFFLE_WINDOW_RENDER_HEIGHT,
+                                              &render_height);
+
+    if (has_render_width != has_render_height) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_RENDER_WIDTH and "
+                     "WAFFLE_WINDOW_RENDER_HEIGHT must be set together");
+        goto error;
+    }
+
+    if (has_render_width) {
+        if (render_width <= 0 || render_width > INT32_MAX) {
+            wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                         "WAFFLE_WINDOW_RENDER_WIDTH is not positive or "
+                         "is greater than INT32_MAX");
+            goto error;
+        }
+
+        if (render_height <= 0 || render_height > INT32_MAX) {
+            wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                         "WAFFLE_WINDOW_RENDER_HEIGHT is not positive or "
+                         "is greater than INT32_MAX");
+            goto error;
+        }
+    }
+
+    // The caller has checked that the parent belongs to the same display.
+    wcore_attrib_list_get(attrib_list_filtered, WAFFLE_WINDOW_PARENT, &parent);
+    if (parent && fullscreen) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_FULLSCREEN and WAFFLE_WINDOW_PARENT "
+                     "are mutually exclusive");
+        goto error;
+    }
+
+    wcore_attrib_list_get(attrib_list_filtered, WAFFLE_WINDOW_GBM_USAGE,
+                          &usage);
+    if (usage & ~(intptr_t) (WCORE_GBM_USAGE_SCANOUT |
+                             WCORE_GBM_USAGE_LINEAR |
+                             WCORE_GBM_USAGE_PROTECTED)) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_GBM_USAGE has bad value %#" PRIxPTR,
+                     usage);
+        goto error;
+    }
+
+    // A null list leaves the layout to the driver.
+    wcore_attrib_list_get(attrib_list_filtered, WAFFLE_WINDOW_GBM_MODIFIERS,
+                          &modifiers_handle);
+    modifiers = (const uint64_t *) modifiers_handle;
+    if (modifiers) {
+        if (modifiers[0] == WCORE_DRM_FORMAT_MOD_INVALID) {
+            wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                         "WAFFLE_WINDOW_GBM_MODIFIERS is empty");
+            goto error;
+        }
+
+        if (usage & WCORE_GBM_USAGE_LINEAR) {
+            wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                         "WAFFLE_GBM_USAGE_LINEAR conflicts with "
+                         "WAFFLE_WINDOW_GBM_MODIFIERS; list "
+                         "DRM_FORMAT_MOD_LINEAR instead");
+            goto error;
+        }
+    }
+
+    // The platform checks the maximum, which depends on its allocator.
+    if (wcore_attrib_list_get(attrib_list_filtered,
+                              WAFFLE_WINDOW_BUFFER_COUNT, &buffer_count) &&
+        buffer_count < 2) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_BUFFER_COUNT is less than 2");
+        goto error;
+    }
+
+    if (fullscreen)
+        width = height = -1;
+
+    *out_width = (int32_t) width;
+    *out_height = (int32_t) height;
+    *filtered = attrib_list_filtered;
+    return true;
+
+error:
+    free(attrib_list_filtered);
+    return false;
+}
@@ -0,0 +1,432 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdlib.h>
+
+#include <cmocka.h>
+
+#include "wcore_attrib_list.h"
+#include "wcore_error.h"
+#include "wcore_window_attrs.h"
+
+// From waffle_gbm.h and drm_fourcc.h.
+#define GBM_USAGE_SCANOUT 0x1
+#define GBM_USAGE_LINEAR 0x2
+#define DRM_FORMAT_MOD_LINEAR 0ULL
+#define DRM_FORMAT_MOD_INVALID 0x00ffffffffffffffULL
+
+struct test_state_wcore_window_attrs {
+    int32_t width;
+    int32_t height;
+    intptr_t *filtered;
+};
+
+static int
+setup(void **state) {
+    struct test_state_wcore_window_attrs *ts;
+
+    ts = calloc(1, sizeof(*ts));
+    if (!ts)
+        return -1;
+
+    *state = ts;
+
+    wcore_error_reset();
+
+    // Canaries.
+    ts->width = 99;
+    ts->height = 99;
+    return 0;
+}
+
+static int
+teardown(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+
+    free(ts->filtered);
+    free(ts);
+    return 0;
+}
+
+static bool
+parse(struct test_state_wcore_window_attrs *ts, const intptr_t attrib_list[])
+{
+    return wcore_window_attrs_parse(attrib_list, &ts->width, &ts->height,
+                                    &ts->filtered);
+}
+
+static void
+assert_bad_attribute(struct test_state_wcore_window_attrs *ts,
+                     const intptr_t attrib_list[])
+{
+    assert_false(parse(ts, attrib_list));
+    assert_int_equal(wcore_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+    assert_null(ts->filtered);
+    assert_int_equal(ts->width, 99);
+    assert_int_equal(ts->height, 99);
+}
+
+static void
+test_wcore_window_attrs_null_attrib_list(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+
+    assert_bad_attribute(ts, NULL);
+}
+
+static void
+test_wcore_window_attrs_size(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        0,
+    };
+
+    assert_true(parse(ts, attrib_list));
+    assert_int_equal(ts->width, 320);
+    assert_int_equal(ts->height, 240);
+    assert_int_equal(wcore_attrib_list_length(ts->filtered), 0);
+}
+
+static void
+test_wcore_window_attrs_missing_height(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        0,
+    };
+
+    assert_bad_attribute(ts, attrib_list);
+}
+
+static void
+test_wcore_window_attrs_zero_width(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 0,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        0,
+    };
+
+    assert_bad_attribute(ts, attrib_list);
+}
+
+static void
+test_wcore_window_attrs_fullscreen(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_FULLSCREEN, true,
+        0,
+    };
+
+    assert_true(parse(ts, attrib_list));
+    assert_int_equal(ts->width, -1);
+    assert_int_equal(ts->height, -1);
+    assert_int_equal(wcore_attrib_list_length(ts->filtered), 0);
+}
+
+static void
+test_wcore_window_attrs_fullscreen_bad_value(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_FULLSCREEN, 2,
+        0,
+    };
+
+    assert_bad_attribute(ts, attrib_list);
+}
+
+static void
+test_wcore_window_attrs_render_size(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        WAFFLE_WINDOW_RENDER_WIDTH, 640,
+        WAFFLE_WINDOW_RENDER_HEIGHT, 480,
+        0,
+    };
+    intptr_t value;
+
+    assert_true(parse(ts, attrib_list));
+    assert_int_equal(ts->width, 320);
+    assert_int_equal(ts->height, 240);
+
+    // The platform reads the render size from the filtered list.
+    assert_int_equal(wcore_attrib_list_length(ts->filtered), 2);
+    assert_true(wcore_attrib_list_get(ts->filtered,
+                                      WAFFLE_WINDOW_RENDER_WIDTH, &value));
+    assert_int_equal(value, 640);
+    assert_true(wcore_attrib_list_get(ts->filtered,
+                                      WAFFLE_WINDOW_RENDER_HEIGHT, &value));
+    assert_int_equal(value, 480);
+}
+
+static void
+test_wcore_window_attrs_render_width_alone(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        WAFFLE_WINDOW_RENDER_WIDTH, 640,
+        0,
+    };
+
+    assert_bad_attribute(ts, attrib_list);
+}
+
+static void
+test_wcore_window_attrs_render_height_not_positive(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        WAFFLE_WINDOW_RENDER_WIDTH, 640,
+        WAFFLE_WINDOW_RENDER_HEIGHT, -480,
+        0,
+    };
+
+    assert_bad_attribute(ts, attrib_list);
+}
+
+static void
+test_wcore_window_attrs_parent(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    intptr_t parent = 0x1000;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_PARENT, parent,
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        0,
+    };
+    intptr_t value;
+
+    assert_true(parse(ts, attrib_list));
+    assert_int_equal(wcore_attrib_list_length(ts->filtered), 1);
+    assert_true(wcore_attrib_list_get(ts->filtered,
+                                      WAFFLE_WINDOW_PARENT, &value));
+    assert_int_equal(value, parent);
+}
+
+static void
+test_wcore_window_attrs_parent_fullscreen(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_PARENT, 0x1000,
+        WAFFLE_WINDOW_FULLSCREEN, true,
+        0,
+    };
+
+    assert_bad_attribute(ts, attrib_list);
+}
+
+static void
+test_wcore_window_attrs_null_parent_fullscreen(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_PARENT, 0,
+        WAFFLE_WINDOW_FULLSCREEN, true,
+        0,
+    };
+
+    assert_true(parse(ts, attrib_list));
+    assert_int_equal(ts->width, -1);
+    assert_int_equal(ts->height, -1);
+}
+
+static void
+test_wcore_window_attrs_gbm_usage(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        WAFFLE_WINDOW_GBM_USAGE, GBM_USAGE_SCANOUT | GBM_USAGE_LINEAR,
+        0,
+    };
+
+    assert_true(parse(ts, attrib_list));
+    assert_int_equal(wcore_attrib_list_length(ts->filtered), 1);
+}
+
+static void
+test_wcore_window_attrs_gbm_usage_bad_bit(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        WAFFLE_WINDOW_GBM_USAGE, 0x8,
+        0,
+    };
+
+    assert_bad_attribute(ts, attrib_list);
+}
+
+static void
+test_wcore_window_attrs_gbm_modifiers(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const uint64_t modifiers[] = {
+        DRM_FORMAT_MOD_LINEAR,
+        DRM_FORMAT_MOD_INVALID,
+    };
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        WAFFLE_WINDOW_GBM_MODIFIERS, (intptr_t) modifiers,
+        WAFFLE_WINDOW_GBM_USAGE, GBM_USAGE_SCANOUT,
+        0,
+    };
+    intptr_t value;
+
+    assert_true(parse(ts, attrib_list));
+    assert_true(wcore_attrib_list_get(ts->filtered,
+                                      WAFFLE_WINDOW_GBM_MODIFIERS, &value));
+    assert_int_equal(value, (intptr_t) modifiers);
+}
+
+static void
+test_wcore_window_attrs_gbm_modifiers_empty(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const uint64_t modifiers[] = {
+        DRM_FORMAT_MOD_INVALID,
+    };
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        WAFFLE_WINDOW_GBM_MODIFIERS, (intptr_t) modifiers,
+        0,
+    };
+
+    assert_bad_attribute(ts, attrib_list);
+}
+
+static void
+test_wcore_window_attrs_gbm_modifiers_null(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        WAFFLE_WINDOW_GBM_MODIFIERS, 0,
+        WAFFLE_WINDOW_GBM_USAGE, GBM_USAGE_LINEAR,
+        0,
+    };
+
+    assert_true(parse(ts, attrib_list));
+}
+
+static void
+test_wcore_window_attrs_gbm_modifiers_and_linear(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const uint64_t modifiers[] = {
+        DRM_FORMAT_MOD_LINEAR,
+        DRM_FORMAT_MOD_INVALID,
+    };
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        WAFFLE_WINDOW_GBM_MODIFIERS, (intptr_t) modifiers,
+        WAFFLE_WINDOW_GBM_USAGE, GBM_USAGE_LINEAR,
+        0,
+    };
+
+    assert_bad_attribute(ts, attrib_list);
+}
+
+static void
+test_wcore_window_attrs_buffer_count(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        WAFFLE_WINDOW_BUFFER_COUNT, 3,
+        0,
+    };
+    intptr_t value;
+
+    assert_true(parse(ts, attrib_list));
+    assert_true(wcore_attrib_list_get(ts->filtered,
+                                      WAFFLE_WINDOW_BUFFER_COUNT, &value));
+    assert_int_equal(value, 3);
+}
+
+static void
+test_wcore_window_attrs_buffer_count_1(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        WAFFLE_WINDOW_BUFFER_COUNT, 1,
+        0,
+    };
+
+    assert_bad_attribute(ts, attrib_list);
+}
+
+static void
+test_wcore_window_attrs_buffer_count_0(void **state) {
+    struct test_state_wcore_window_attrs *ts = *state;
+    const intptr_t attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH, 320,
+        WAFFLE_WINDOW_HEIGHT, 240,
+        WAFFLE_WINDOW_BUFFER_COUNT, 0,
+        0,
+    };
+
+    assert_bad_attribute(ts, attrib_list);
+}
+
+int
+main(void) {
+    const struct CMUnitTest tests[] = {
+        #define unit_test_make(name) cmocka_unit_test_setup_teardown(name, setup, teardown)
+
+        unit_test_make(test_wcore_window_attrs_null_attrib_list),
+        unit_test_make(test_wcore_window_attrs_size),
+        unit_test_make(test_wcore_window_attrs_missing_height),
+        unit_test_make(test_wcore_window_attrs_zero_width),
+        unit_test_make(test_wcore_window_attrs_fullscreen),
+        unit_test_make(test_wcore_window_attrs_fullscreen_bad_value),
+        unit_test_make(test_wcore_window_attrs_render_size),
+        unit_test_make(test_wcore_window_attrs_render_width_alone),
+        unit_test_make(test_wcore_window_attrs_render_height_not_positive),
+        unit_test_make(test_wcore_window_attrs_parent),
+        unit_test_make(test_wcore_window_attrs_parent_fullscreen),
+        unit_test_make(test_wcore_window_attrs_null_parent_fullscreen),
+        unit_test_make(test_wcore_window_attrs_gbm_usage),
+        unit_test_make(test_wcore_window_attrs_gbm_usage_bad_bit),
+        unit_test_make(test_wcore_window_attrs_gbm_modifiers),
+        unit_test_make(test_wcore_window_attrs_gbm_modifiers_empty),
+        unit_test_make(test_wcore_window_attrs_gbm_modifiers_null),
+        unit_test_make(test_wcore_window_attrs_gbm_modifiers_and_linear),
+        unit_test_make(test_wcore_window_attrs_buffer_count),
+        unit_test_make(test_wcore_window_attrs_buffer_count_1),
+        unit_test_make(test_wcore_window_attrs_buffer_count_0),
+
+        #undef unit_test_make
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
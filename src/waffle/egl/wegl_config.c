@@ -37,9 +37,9 @@
 #include "wegl_util.h"
 
 /// @brief Check the WAFFLE_CONTEXT_* attributes.
-static bool
-check_context_attrs(struct wegl_display *dpy,
-                    const struct wcore_config_attrs *attrs)
+bool
+wegl_config_check_context_attrs(struct wegl_display *dpy,
+                                const struct wcore_config_attrs *attrs)
 {
     if (attrs->context_forward_compatible) {
         assert(attrs->context_api == WAFFLE_CONTEXT_OPENGL);
@@ -72,6 +72,37 @@ check_context_attrs(struct wegl_display *dpy,
         return false;
     }
 
+    if (attrs->context_no_error && !dpy->KHR_create_context_no_error) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_create_context_no_error is required in order to "
+                     "request a no-error context");
+        return false;
+    }
+
+    if (attrs->context_priority != WAFFLE_CONTEXT_PRIORITY_MEDIUM &&
+        !dpy->IMG_context_priority) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_IMG_context_priority is required in order to "
+                     "request a context priority");
+        return false;
+    }
+
+    if (attrs->context_priority == WAFFLE_CONTEXT_PRIORITY_REALTIME &&
+        !dpy->NV_context_priority_realtime) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_NV_context_priority_realtime is required in order "
+                     "to request a realtime context");
+        return false;
+    }
+
+    if (attrs->context_release_behavior != WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH &&
+        !dpy->KHR_context_flush_control) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_context_flush_control is required in order to "
+                     "request a context release behavior");
+        return false;
+    }
+
     switch (attrs->context_api) {
         case WAFFLE_CONTEXT_OPENGL:
             if (!(dpy->api_mask & WEGL_OPENGL_API)) {
@@ -228,7 +259,7 @@ wegl_config_choose(struct wcore_platform *wc_plat,
     if (!ok)
         goto fail;
 
-    if (!check_context_attrs(dpy, attrs))
+    if (!wegl_config_check_context_attrs(dpy, attrs))
         goto fail;
 
     config->egl = choose_real_config(dpy, attrs);
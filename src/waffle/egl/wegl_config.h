@@ -54,3 +54,9 @@ wegl_config_choose(struct wcore_platform *wc_plat,
 
 bool
 wegl_config_destroy(struct wcore_config *wc_config);
+
+/// Check that the display can create a context with the context attributes
+/// of @a attrs.
+bool
+wegl_config_check_context_attrs(struct wegl_display *dpy,
+                                const struct wcore_config_attrs *attrs);
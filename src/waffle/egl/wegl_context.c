@@ -64,14 +64,46 @@ bind_api(struct wegl_platform *plat, int32_t waffle_context_api)
     return ok;
 }
 
+static EGLint
+priority_to_egl(int32_t priority)
+{
+    switch (priority) {
+        case WAFFLE_CONTEXT_PRIORITY_LOW:
+            return EGL_CONTEXT_PRIORITY_LOW_IMG;
+        case WAFFLE_CONTEXT_PRIORITY_HIGH:
+            return EGL_CONTEXT_PRIORITY_HIGH_IMG;
+        case WAFFLE_CONTEXT_PRIORITY_REALTIME:
+            return EGL_CONTEXT_PRIORITY_REALTIME_NV;
+        case WAFFLE_CONTEXT_PRIORITY_MEDIUM:
+        default:
+            return EGL_CONTEXT_PRIORITY_MEDIUM_IMG;
+    }
+}
+
+static int32_t
+priority_from_egl(EGLint priority)
+{
+    switch (priority) {
+        case EGL_CONTEXT_PRIORITY_LOW_IMG:
+            return WAFFLE_CONTEXT_PRIORITY_LOW;
+        case EGL_CONTEXT_PRIORITY_HIGH_IMG:
+            return WAFFLE_CONTEXT_PRIORITY_HIGH;
+        case EGL_CONTEXT_PRIORITY_REALTIME_NV:
+            return WAFFLE_CONTEXT_PRIORITY_REALTIME;
+        case EGL_CONTEXT_PRIORITY_MEDIUM_IMG:
+        default:
+            return WAFFLE_CONTEXT_PRIORITY_MEDIUM;
+    }
+}
+
 static EGLContext
-create_real_context(struct wegl_config *config,
+create_real_context(struct wegl_display *dpy,
+                    const struct wcore_config_attrs *attrs,
+                    EGLConfig egl_config,
                     EGLContext share_ctx)
 
 {
-    struct wegl_display *dpy = wegl_display(config->wcore.display);
     struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
-    struct wcore_config_attrs *attrs = &config->wcore.attrs;
     int32_t waffle_context_api = attrs->context_api;
     EGLint attrib_list[64];
     EGLint context_flags = 0;
@@ -162,6 +194,23 @@ create_real_context(struct wegl_config *config,
             return EGL_NO_CONTEXT;
     }
 
+    if (attrs->context_no_error) {
+        attrib_list[i++] = EGL_CONTEXT_OPENGL_NO_ERROR_KHR;
+        attrib_list[i++] = EGL_TRUE;
+    }
+
+    // Medium is EGL's default, so request it only implicitly.
+    if (attrs->context_priority != WAFFLE_CONTEXT_PRIORITY_MEDIUM) {
+        attrib_list[i++] = EGL_CONTEXT_PRIORITY_LEVEL_IMG;
+        attrib_list[i++] = priority_to_egl(attrs->context_priority);
+    }
+
+    // Flush is EGL's default.
+    if (attrs->context_release_behavior == WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE) {
+        attrib_list[i++] = EGL_CONTEXT_RELEASE_BEHAVIOR_KHR;
+        attrib_list[i++] = EGL_CONTEXT_RELEASE_BEHAVIOR_NONE_KHR;
+    }
+
     if (context_flags != 0) {
         attrib_list[i++] = EGL_CONTEXT_FLAGS_KHR;
         attrib_list[i++] = context_flags;
@@ -172,7 +221,7 @@ create_real_context(struct wegl_config *config,
     if (!bind_api(plat, waffle_context_api))
         return EGL_NO_CONTEXT;
 
-    EGLContext ctx = plat->eglCreateContext(dpy->egl, config->egl,
+    EGLContext ctx = plat->eglCreateContext(dpy->egl, egl_config,
                                             share_ctx, attrib_list);
     if (!ctx)
         wegl_emit_error(plat, "eglCreateContext");
@@ -193,7 +242,9 @@ wegl_context_init(struct wegl_context *ctx,
     if (!ok)
         goto fail;
 
-    ctx->egl = create_real_context(config,
+    ctx->egl = create_real_context(wegl_display(config->wcore.display),
+                                   &config->wcore.attrs,
+                                   config->egl,
                                    share_ctx
                                        ? share_ctx->egl
                                        : EGL_NO_CONTEXT);
@@ -228,6 +279,51 @@ wegl_context_create(struct wcore_platform *wc_plat,
     return &ctx->wcore;
 }
 
+struct wcore_context*
+wegl_context_create_no_config(struct wcore_platform *wc_plat,
+                              struct wcore_display *wc_dpy,
+                              const struct wcore_config_attrs *attrs,
+                              struct wcore_context *wc_share_ctx)
+{
+    struct wegl_display *dpy = wegl_display(wc_dpy);
+    struct wegl_context *share_ctx = wegl_context(wc_share_ctx);
+    struct wegl_context *ctx;
+
+    (void) wc_plat;
+
+    if (!dpy->KHR_no_config_context) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_no_config_context is required in order to "
+                     "create a context without a config");
+        return NULL;
+    }
+
+    if (!wegl_config_check_context_attrs(dpy, attrs))
+        return NULL;
+
+    ctx = wcore_calloc(sizeof(*ctx));
+    if (!ctx)
+        return NULL;
+
+    if (!wcore_context_init_no_config(&ctx->wcore, wc_dpy, attrs))
+        goto fail;
+
+    // The context can be made current with a surface of any config whose
+    // EGL_RENDERABLE_TYPE includes the context's API.
+    ctx->egl = create_real_context(dpy, attrs, EGL_NO_CONFIG_KHR,
+                                   share_ctx
+                                       ? share_ctx->egl
+                                       : EGL_NO_CONTEXT);
+    if (ctx->egl == EGL_NO_CONTEXT)
+        goto fail;
+
+    return &ctx->wcore;
+
+fail:
+    wegl_context_destroy(&ctx->wcore);
+    return NULL;
+}
+
 bool
 wegl_context_teardown(struct wegl_context *ctx)
 {
@@ -262,3 +358,39 @@ wegl_context_destroy(struct wcore_context *wc_ctx)
     }
     return result;
 }
+
+bool
+wegl_context_get_attrib(struct wcore_context *wc_ctx,
+                        int32_t attrib,
+                        intptr_t *value)
+{
+    struct wegl_context *ctx = wegl_context(wc_ctx);
+    struct wegl_display *dpy = wegl_display(wc_ctx->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    EGLint priority;
+
+    switch (attrib) {
+        case WAFFLE_CONTEXT_PRIORITY:
+            break;
+        default:
+            wcore_error_bad_attribute(attrib);
+            return false;
+    }
+
+    // Without the extension, every context has the default priority.
+    if (!dpy->IMG_context_priority) {
+        *value = WAFFLE_CONTEXT_PRIORITY_MEDIUM;
+        return true;
+    }
+
+    // The driver may grant a lower priority than requested, for example when
+    // the process lacks the privilege for a higher one.
+    if (!plat->eglQueryContext(dpy->egl, ctx->egl,
+                               EGL_CONTEXT_PRIORITY_LEVEL_IMG, &priority)) {
+        wegl_emit_error(plat, "eglQueryContext");
+        return false;
+    }
+
+    *value = priority_from_egl(priority);
+    return true;
+}
@@ -56,5 +56,16 @@ wegl_context_create(struct wcore_platform *wc_plat,
                     struct wcore_config *wc_config,
                     struct wcore_context *wc_share_ctx);
 
+struct wcore_context*
+wegl_context_create_no_config(struct wcore_platform *wc_plat,
+                              struct wcore_display *wc_dpy,
+                              const struct wcore_config_attrs *attrs,
+                              struct wcore_context *wc_share_ctx);
+
 bool
 wegl_context_destroy(struct wcore_context *wc_ctx);
+
+bool
+wegl_context_get_attrib(struct wcore_context *wc_ctx,
+                        int32_t attrib,
+                        intptr_t *value);
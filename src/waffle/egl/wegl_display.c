@@ -86,6 +86,22 @@ get_extensions(struct wegl_display *dpy)
 
     dpy->EXT_create_context_robustness = waffle_is_extension_in_string(extensions, "EGL_EXT_create_context_robustness");
     dpy->KHR_create_context = waffle_is_extension_in_string(extensions, "EGL_KHR_create_context");
+    dpy->KHR_create_context_no_error = waffle_is_extension_in_string(extensions, "EGL_KHR_create_context_no_error");
+    dpy->IMG_context_priority = waffle_is_extension_in_string(extensions, "EGL_IMG_context_priority");
+    dpy->NV_context_priority_realtime = waffle_is_extension_in_string(extensions, "EGL_NV_context_priority_realtime");
+    dpy->KHR_context_flush_control = waffle_is_extension_in_string(extensions, "EGL_KHR_context_flush_control");
+    // EGL_MESA_configless_context predates the KHR extension and has the
+    // same semantics and token value.
+    dpy->KHR_no_config_context = waffle_is_extension_in_string(extensions, "EGL_KHR_no_config_context") ||
+                                 waffle_is_extension_in_string(extensions, "EGL_MESA_configless_context");
+    dpy->KHR_image_base = waffle_is_extension_in_string(extensions, "EGL_KHR_image_base");
+    dpy->EXT_image_dma_buf_import = waffle_is_extension_in_string(extensions, "EGL_EXT_image_dma_buf_import");
+    dpy->EXT_image_dma_buf_import_modifiers = waffle_is_extension_in_string(extensions, "EGL_EXT_image_dma_buf_import_modifiers");
+    dpy->KHR_gl_texture_2D_image = waffle_is_extension_in_string(extensions, "EGL_KHR_gl_texture_2D_image");
+    dpy->MESA_image_dma_buf_export = waffle_is_extension_in_string(extensions, "EGL_MESA_image_dma_buf_export");
+    dpy->KHR_fence_sync = waffle_is_extension_in_string(extensions, "EGL_KHR_fence_sync");
+    dpy->KHR_wait_sync = waffle_is_extension_in_string(extensions, "EGL_KHR_wait_sync");
+    dpy->ANDROID_native_fence_sync = waffle_is_extension_in_string(extensions, "EGL_ANDROID_native_fence_sync");
 
     return true;
 }
@@ -137,7 +153,7 @@ wegl_display_teardown(struct wegl_display *dpy)
     struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
     bool ok = true;
 
-    if (dpy->egl) {
+    if (dpy->egl && !dpy->adopted) {
         ok = plat->eglTerminate(dpy->egl);
         if (!ok)
             wegl_emit_error(plat, "eglTerminate");
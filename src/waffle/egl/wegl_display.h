@@ -42,9 +42,29 @@ enum wegl_supported_api {
 struct wegl_display {
     struct wcore_display wcore;
     EGLDisplay egl;
+
+    /// @brief The native display belongs to the application.
+    ///
+    /// EGL returns the same EGLDisplay for the same native display and does
+    /// not reference count initialization, so waffle must not terminate it.
+    bool adopted;
+
     enum wegl_supported_api api_mask;
     bool EXT_create_context_robustness;
+    bool EXT_image_dma_buf_import;
+    bool EXT_image_dma_buf_import_modifiers;
+    bool ANDROID_native_fence_sync;
     bool KHR_create_context;
+    bool KHR_create_context_no_error;
+    bool IMG_context_priority;
+    bool NV_context_priority_realtime;
+    bool KHR_context_flush_control;
+    bool KHR_no_config_context;
+    bool KHR_fence_sync;
+    bool KHR_gl_texture_2D_image;
+    bool KHR_image_base;
+    bool KHR_wait_sync;
+    bool MESA_image_dma_buf_export;
     EGLint major_version;
     EGLint minor_version;
 };
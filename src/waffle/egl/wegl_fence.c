@@ -0,0 +1,164 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdlib.h>
+
+#include "wcore_context.h"
+#include "wcore_error.h"
+
+#include "wegl_display.h"
+#include "wegl_fence.h"
+#include "wegl_platform.h"
+#include "wegl_util.h"
+
+struct wcore_fence*
+wegl_fence_create(struct wcore_context *wc_ctx)
+{
+    struct wegl_display *dpy = wegl_display(wc_ctx->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    struct wegl_fence *self;
+    EGLenum type;
+
+    if (!dpy->KHR_fence_sync || !plat->eglCreateSyncKHR ||
+        !plat->eglDestroySyncKHR || !plat->eglClientWaitSyncKHR) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_fence_sync is unsupported");
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    wcore_fence_init(&self->wcore, wc_ctx->display);
+
+    // Prefer a native fence, which waits like a plain one but can also be
+    // exported.
+    self->native = dpy->ANDROID_native_fence_sync &&
+                   plat->eglDupNativeFenceFDANDROID;
+    type = self->native ? EGL_SYNC_NATIVE_FENCE_ANDROID : EGL_SYNC_FENCE_KHR;
+
+    self->egl = plat->eglCreateSyncKHR(dpy->egl, type, NULL);
+    if (self->egl == EGL_NO_SYNC_KHR) {
+        wegl_emit_error(plat, "eglCreateSyncKHR");
+        free(self);
+        return NULL;
+    }
+
+    return &self->wcore;
+}
+
+bool
+wegl_fence_destroy(struct wcore_fence *wc_self)
+{
+    struct wegl_fence *self = wegl_fence(wc_self);
+    struct wegl_display *dpy = wegl_display(wc_self->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    bool ok = true;
+
+    if (!plat->eglDestroySyncKHR(dpy->egl, self->egl)) {
+        wegl_emit_error(plat, "eglDestroySyncKHR");
+        ok = false;
+    }
+
+    ok &= wcore_fence_teardown(wc_self);
+    free(self);
+    return ok;
+}
+
+bool
+wegl_fence_wait(struct wcore_fence *wc_self,
+                uint64_t timeout_ns,
+                bool *signaled)
+{
+    struct wegl_fence *self = wegl_fence(wc_self);
+    struct wegl_display *dpy = wegl_display(wc_self->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    EGLint status;
+
+    // EGL_FOREVER_KHR and WAFFLE_FENCE_FOREVER are both the largest value.
+    status = plat->eglClientWaitSyncKHR(dpy->egl, self->egl,
+                                        EGL_SYNC_FLUSH_COMMANDS_BIT_KHR,
+                                        (EGLTimeKHR) timeout_ns);
+    if (status == EGL_FALSE) {
+        wegl_emit_error(plat, "eglClientWaitSyncKHR");
+        return false;
+    }
+
+    *signaled = status != EGL_TIMEOUT_EXPIRED_KHR;
+    return true;
+}
+
+bool
+wegl_fence_server_wait(struct wcore_fence *wc_self)
+{
+    struct wegl_fence *self = wegl_fence(wc_self);
+    struct wegl_display *dpy = wegl_display(wc_self->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+
+    if (!dpy->KHR_wait_sync || !plat->eglWaitSyncKHR) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_wait_sync is unsupported");
+        return false;
+    }
+
+    if (plat->eglWaitSyncKHR(dpy->egl, self->egl, 0) == EGL_FALSE) {
+        wegl_emit_error(plat, "eglWaitSyncKHR");
+        return false;
+    }
+
+    return true;
+}
+
+bool
+wegl_fence_export_fd(struct wcore_fence *wc_self, int *fd)
+{
+    struct wegl_fence *self = wegl_fence(wc_self);
+    struct wegl_display *dpy = wegl_display(wc_self->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+
+    if (!self->native) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_ANDROID_native_fence_sync is unsupported");
+        return false;
+    }
+
+    // The driver creates the sync file when it flushes the fence, so flush
+    // without waiting.
+    if (plat->eglClientWaitSyncKHR(dpy->egl, self->egl,
+                                   EGL_SYNC_FLUSH_COMMANDS_BIT_KHR,
+                                   0) == EGL_FALSE) {
+        wegl_emit_error(plat, "eglClientWaitSyncKHR");
+        return false;
+    }
+
+    *fd = plat->eglDupNativeFenceFDANDROID(dpy->egl, self->egl);
+    if (*fd == EGL_NO_NATIVE_FENCE_FD_ANDROID) {
+        wegl_emit_error(plat, "eglDupNativeFenceFDANDROID");
+        return false;
+    }
+
+    return true;
+}
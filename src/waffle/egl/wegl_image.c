@@ -0,0 +1,313 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "wcore_error.h"
+
+#include "wegl_context.h"
+#include "wegl_display.h"
+#include "wegl_image.h"
+#include "wegl_imports.h"
+#include "wegl_platform.h"
+#include "wegl_util.h"
+
+// From drm_fourcc.h, which the EGL platforms do not otherwise need.
+#define WEGL_DRM_FORMAT_MOD_INVALID 0x00ffffffffffffffULL
+
+// From GLES2/gl2ext.h.
+#define WEGL_GL_TEXTURE_2D              0x0DE1
+#define WEGL_GL_TEXTURE_EXTERNAL_OES    0x8D65
+
+static const EGLint plane_attribs[WAFFLE_DMABUF_MAX_PLANES][5] = {
+    {
+        EGL_DMA_BUF_PLANE0_FD_EXT,
+        EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+        EGL_DMA_BUF_PLANE0_PITCH_EXT,
+        EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
+        EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT,
+    },
+    {
+        EGL_DMA_BUF_PLANE1_FD_EXT,
+        EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+        EGL_DMA_BUF_PLANE1_PITCH_EXT,
+        EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
+        EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT,
+    },
+    {
+        EGL_DMA_BUF_PLANE2_FD_EXT,
+        EGL_DMA_BUF_PLANE2_OFFSET_EXT,
+        EGL_DMA_BUF_PLANE2_PITCH_EXT,
+        EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT,
+        EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT,
+    },
+    {
+        EGL_DMA_BUF_PLANE3_FD_EXT,
+        EGL_DMA_BUF_PLANE3_OFFSET_EXT,
+        EGL_DMA_BUF_PLANE3_PITCH_EXT,
+        EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT,
+        EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT,
+    },
+};
+
+struct wcore_image*
+wegl_image_create_from_dmabuf(struct wcore_display *wc_dpy,
+                              const struct waffle_dmabuf *dmabuf)
+{
+    struct wegl_display *dpy = wegl_display(wc_dpy);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    struct wegl_image *self;
+    bool has_modifier = dmabuf->modifier != WEGL_DRM_FORMAT_MOD_INVALID;
+
+    if (!dpy->KHR_image_base || !dpy->EXT_image_dma_buf_import ||
+        !plat->eglCreateImageKHR || !plat->eglDestroyImageKHR) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_EXT_image_dma_buf_import is unsupported");
+        return NULL;
+    }
+
+    // Plane 3 was added by the modifiers extension.
+    if ((has_modifier || dmabuf->num_planes > 3) &&
+        !dpy->EXT_image_dma_buf_import_modifiers) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_EXT_image_dma_buf_import_modifiers is unsupported");
+        return NULL;
+    }
+
+    // 3 pairs for the size and format, up to 5 pairs per plane, and EGL_NONE.
+    EGLint attrib_list[2 * (3 + 5 * WAFFLE_DMABUF_MAX_PLANES) + 1];
+    int i = 0;
+
+    attrib_list[i++] = EGL_WIDTH;
+    attrib_list[i++] = dmabuf->width;
+    attrib_list[i++] = EGL_HEIGHT;
+    attrib_list[i++] = dmabuf->height;
+    attrib_list[i++] = EGL_LINUX_DRM_FOURCC_EXT;
+    attrib_list[i++] = (EGLint) dmabuf->fourcc;
+
+    for (int p = 0; p < dmabuf->num_planes; ++p) {
+        attrib_list[i++] = plane_attribs[p][0];
+        attrib_list[i++] = dmabuf->fds[p];
+        attrib_list[i++] = plane_attribs[p][1];
+        attrib_list[i++] = (EGLint) dmabuf->offsets[p];
+        attrib_list[i++] = plane_attribs[p][2];
+        attrib_list[i++] = (EGLint) dmabuf->strides[p];
+
+        if (has_modifier) {
+            attrib_list[i++] = plane_attribs[p][3];
+            attrib_list[i++] = (EGLint) (dmabuf->modifier & 0xffffffff);
+            attrib_list[i++] = plane_attribs[p][4];
+            attrib_list[i++] = (EGLint) (dmabuf->modifier >> 32);
+        }
+    }
+
+    attrib_list[i++] = EGL_NONE;
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    wcore_image_init(&self->wcore, wc_dpy);
+    self->width = dmabuf->width;
+    self->height = dmabuf->height;
+
+    // EGL dups the fds, so the caller keeps ownership of them.
+    self->egl = plat->eglCreateImageKHR(dpy->egl, EGL_NO_CONTEXT,
+                                        EGL_LINUX_DMA_BUF_EXT, NULL,
+                                        attrib_list);
+    if (self->egl == EGL_NO_IMAGE_KHR) {
+        wegl_emit_error(plat, "eglCreateImageKHR");
+        free(self);
+        return NULL;
+    }
+
+    return &self->wcore;
+}
+
+struct wcore_image*
+wegl_image_create_from_texture(struct wcore_context *wc_ctx,
+                               uint32_t texture,
+                               int32_t width,
+                               int32_t height)
+{
+    struct wegl_context *ctx = wegl_context(wc_ctx);
+    struct wegl_display *dpy = wegl_display(wc_ctx->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    struct wegl_image *self;
+
+    if (!dpy->KHR_image_base || !dpy->KHR_gl_texture_2D_image ||
+        !plat->eglCreateImageKHR || !plat->eglDestroyImageKHR) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_KHR_gl_texture_2D_image is unsupported");
+        return NULL;
+    }
+
+    // Preserve the texture's contents, so that a consumer sees what the
+    // producer rendered before the image was created.
+    const EGLint attrib_list[] = {
+        EGL_GL_TEXTURE_LEVEL_KHR, 0,
+        EGL_IMAGE_PRESERVED_KHR, EGL_TRUE,
+        EGL_NONE,
+    };
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    wcore_image_init(&self->wcore, wc_ctx->display);
+    self->width = width;
+    self->height = height;
+
+    self->egl = plat->eglCreateImageKHR(dpy->egl, ctx->egl,
+                                        EGL_GL_TEXTURE_2D_KHR,
+                                        (EGLClientBuffer) (uintptr_t) texture,
+                                        attrib_list);
+    if (self->egl == EGL_NO_IMAGE_KHR) {
+        wegl_emit_error(plat, "eglCreateImageKHR");
+        free(self);
+        return NULL;
+    }
+
+    return &self->wcore;
+}
+
+bool
+wegl_image_destroy(struct wcore_image *wc_self)
+{
+    struct wegl_image *self = wegl_image(wc_self);
+    struct wegl_display *dpy = wegl_display(wc_self->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    bool ok = true;
+
+    if (self->egl != EGL_NO_IMAGE_KHR) {
+        ok = plat->eglDestroyImageKHR(dpy->egl, self->egl);
+        if (!ok)
+            wegl_emit_error(plat, "eglDestroyImageKHR");
+    }
+
+    ok &= wcore_image_teardown(wc_self);
+    free(self);
+    return ok;
+}
+
+bool
+wegl_image_bind_texture(struct wcore_image *wc_self, uint32_t target)
+{
+    struct wegl_image *self = wegl_image(wc_self);
+    struct wegl_platform *plat = wegl_platform(wc_self->display->platform);
+
+    if (target != WEGL_GL_TEXTURE_2D &&
+        target != WEGL_GL_TEXTURE_EXTERNAL_OES) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "target %#x is not GL_TEXTURE_2D or "
+                     "GL_TEXTURE_EXTERNAL_OES", target);
+        return false;
+    }
+
+    if (!plat->glEGLImageTargetTexture2DOES) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "glEGLImageTargetTexture2DOES is unavailable");
+        return false;
+    }
+
+    plat->glEGLImageTargetTexture2DOES(target, self->egl);
+    return true;
+}
+
+bool
+wegl_image_export_dmabuf(struct wcore_image *wc_self,
+                         struct waffle_dmabuf *dmabuf)
+{
+    struct wegl_image *self = wegl_image(wc_self);
+    struct wegl_display *dpy = wegl_display(wc_self->display);
+    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    int fourcc = 0;
+    int num_planes = 0;
+    uint64_t modifiers[WAFFLE_DMABUF_MAX_PLANES];
+    int fds[WAFFLE_DMABUF_MAX_PLANES];
+    EGLint strides[WAFFLE_DMABUF_MAX_PLANES];
+    EGLint offsets[WAFFLE_DMABUF_MAX_PLANES];
+    bool ok;
+
+    if (!dpy->MESA_image_dma_buf_export ||
+        !plat->eglExportDMABUFImageQueryMESA ||
+        !plat->eglExportDMABUFImageMESA) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_MESA_image_dma_buf_export is unsupported");
+        return false;
+    }
+
+    ok = plat->eglExportDMABUFImageQueryMESA(dpy->egl, self->egl, &fourcc,
+                                             &num_planes, NULL);
+    if (!ok) {
+        wegl_emit_error(plat, "eglExportDMABUFImageQueryMESA");
+        return false;
+    }
+
+    if (num_planes < 1 || num_planes > WAFFLE_DMABUF_MAX_PLANES) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "eglExportDMABUFImageQueryMESA returned %d planes",
+                     num_planes);
+        return false;
+    }
+
+    ok = plat->eglExportDMABUFImageQueryMESA(dpy->egl, self->egl, NULL,
+                                             NULL, modifiers);
+    if (!ok) {
+        wegl_emit_error(plat, "eglExportDMABUFImageQueryMESA");
+        return false;
+    }
+
+    for (int i = 0; i < WAFFLE_DMABUF_MAX_PLANES; ++i)
+        fds[i] = -1;
+
+    ok = plat->eglExportDMABUFImageMESA(dpy->egl, self->egl, fds, strides,
+                                        offsets);
+    if (!ok) {
+        wegl_emit_error(plat, "eglExportDMABUFImageMESA");
+        return false;
+    }
+
+    dmabuf->width = self->width;
+    dmabuf->height = self->height;
+    dmabuf->fourcc = (uint32_t) fourcc;
+    dmabuf->modifier = modifiers[0];
+    dmabuf->num_planes = num_planes;
+
+    for (int i = 0; i < WAFFLE_DMABUF_MAX_PLANES; ++i) {
+        if (i < num_planes) {
+            dmabuf->fds[i] = fds[i];
+            dmabuf->offsets[i] = (uint32_t) offsets[i];
+            dmabuf->strides[i] = (uint32_t) strides[i];
+        } else {
+            dmabuf->fds[i] = -1;
+            dmabuf->offsets[i] = 0;
+            dmabuf->strides[i] = 0;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,78 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "wcore_image.h"
+
+#include "wegl_imports.h"
+
+struct wcore_context;
+struct wcore_display;
+struct waffle_dmabuf;
+
+struct wegl_image {
+    struct wcore_image wcore;
+    EGLImageKHR egl;
+
+    // EGL has no query for the size of an image, and the importer of an
+    // exported image needs it.
+    int32_t width;
+    int32_t height;
+};
+
+DEFINE_CONTAINER_CAST_FUNC(wegl_image,
+                           struct wegl_image,
+                           struct wcore_image,
+                           wcore)
+
+/// Requires EGL_EXT_image_dma_buf_import, and for a modifier other than
+/// DRM_FORMAT_MOD_INVALID also EGL_EXT_image_dma_buf_import_modifiers.
+struct wcore_image*
+wegl_image_create_from_dmabuf(struct wcore_display *wc_dpy,
+                              const struct waffle_dmabuf *dmabuf);
+
+/// Requires EGL_KHR_gl_texture_2D_image.
+struct wcore_image*
+wegl_image_create_from_texture(struct wcore_context *wc_ctx,
+                               uint32_t texture,
+                               int32_t width,
+                               int32_t height);
+
+bool
+wegl_image_destroy(struct wcore_image *wc_self);
+
+/// Requires GL_OES_EGL_image, or GL_OES_EGL_image_external for
+/// GL_TEXTURE_EXTERNAL_OES, in the current context.
+bool
+wegl_image_bind_texture(struct wcore_image *wc_self, uint32_t target);
+
+/// Requires EGL_MESA_image_dma_buf_export.
+bool
+wegl_image_export_dmabuf(struct wcore_image *wc_self,
+                         struct waffle_dmabuf *dmabuf);
@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <EGL/egl.h>
 #include <EGL/eglext.h>
 
@@ -51,3 +53,110 @@
 #define EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR    0x00000002
 #define EGL_OPENGL_ES3_BIT_KHR                              0x00000040
 #endif
+
+#ifndef EGL_KHR_create_context_no_error
+#define EGL_KHR_create_context_no_error 1
+#define EGL_CONTEXT_OPENGL_NO_ERROR_KHR                     0x31B3
+#endif
+
+#ifndef EGL_IMG_context_priority
+#define EGL_IMG_context_priority 1
+#define EGL_CONTEXT_PRIORITY_LEVEL_IMG                      0x3100
+#define EGL_CONTEXT_PRIORITY_HIGH_IMG                       0x3101
+#define EGL_CONTEXT_PRIORITY_MEDIUM_IMG                     0x3102
+#define EGL_CONTEXT_PRIORITY_LOW_IMG                        0x3103
+#endif
+
+#ifndef EGL_NV_context_priority_realtime
+#define EGL_NV_context_priority_realtime 1
+#define EGL_CONTEXT_PRIORITY_REALTIME_NV                    0x3357
+#endif
+
+#ifndef EGL_KHR_context_flush_control
+#define EGL_KHR_context_flush_control 1
+#define EGL_CONTEXT_RELEASE_BEHAVIOR_NONE_KHR               0
+#define EGL_CONTEXT_RELEASE_BEHAVIOR_KHR                    0x2097
+#define EGL_CONTEXT_RELEASE_BEHAVIOR_FLUSH_KHR              0x2098
+#endif
+
+#ifndef EGL_KHR_no_config_context
+#define EGL_KHR_no_config_context 1
+#define EGL_NO_CONFIG_KHR                                   ((EGLConfig)0)
+#endif
+
+#ifndef EGL_KHR_image_base
+#define EGL_KHR_image_base 1
+typedef void *EGLImageKHR;
+#define EGL_NO_IMAGE_KHR                                    ((EGLImageKHR)0)
+#define EGL_IMAGE_PRESERVED_KHR                             0x30D2
+#endif
+
+#ifndef EGL_EXT_image_dma_buf_import
+#define EGL_EXT_image_dma_buf_import 1
+#define EGL_LINUX_DMA_BUF_EXT                               0x3270
+#define EGL_LINUX_DRM_FOURCC_EXT                            0x3271
+#define EGL_DMA_BUF_PLANE0_FD_EXT                           0x3272
+#define EGL_DMA_BUF_PLANE0_OFFSET_EXT                       0x3273
+#define EGL_DMA_BUF_PLANE0_PITCH_EXT                        0x3274
+#define EGL_DMA_BUF_PLANE1_FD_EXT                           0x3275
+#define EGL_DMA_BUF_PLANE1_OFFSET_EXT                       0x3276
+#define EGL_DMA_BUF_PLANE1_PITCH_EXT                        0x3277
+#define EGL_DMA_BUF_PLANE2_FD_EXT                           0x3278
+#define EGL_DMA_BUF_PLANE2_OFFSET_EXT                       0x3279
+#define EGL_DMA_BUF_PLANE2_PITCH_EXT                        0x327A
+#endif
+
+#ifndef EGL_EXT_image_dma_buf_import_modifiers
+#define EGL_EXT_image_dma_buf_import_modifiers 1
+#define EGL_DMA_BUF_PLANE3_FD_EXT                           0x3440
+#define EGL_DMA_BUF_PLANE3_OFFSET_EXT                       0x3441
+#define EGL_DMA_BUF_PLANE3_PITCH_EXT                        0x3442
+#define EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT                  0x3443
+#define EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT                  0x3444
+#define EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT                  0x3445
+#define EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT                  0x3446
+#define EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT                  0x3447
+#define EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT                  0x3448
+#define EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT                  0x3449
+#define EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT                  0x344A
+#endif
+
+#ifndef EGL_KHR_gl_texture_2D_image
+#define EGL_KHR_gl_texture_2D_image 1
+#define EGL_GL_TEXTURE_2D_KHR                               0x30B1
+#define EGL_GL_TEXTURE_LEVEL_KHR                            0x30BC
+#endif
+
+#ifndef EGL_KHR_fence_sync
+#define EGL_KHR_fence_sync 1
+typedef void *EGLSyncKHR;
+typedef uint64_t EGLTimeKHR;
+#define EGL_NO_SYNC_KHR                                     ((EGLSyncKHR)0)
+#define EGL_SYNC_FLUSH_COMMANDS_BIT_KHR                     0x0001
+#define EGL_FOREVER_KHR                                     0xFFFFFFFFFFFFFFFFull
+#define EGL_TIMEOUT_EXPIRED_KHR                             0x30F5
+#define EGL_CONDITION_SATISFIED_KHR                         0x30F6
+#define EGL_SYNC_FENCE_KHR                                  0x30F9
+#endif
+
+#ifndef EGL_ANDROID_native_fence_sync
+#define EGL_ANDROID_native_fence_sync 1
+#define EGL_SYNC_NATIVE_FENCE_ANDROID                       0x3144
+#define EGL_NO_NATIVE_FENCE_FD_ANDROID                      -1
+#endif
+
+#ifndef EGL_EXT_device_base
+#define EGL_EXT_device_base 1
+typedef void *EGLDeviceEXT;
+#define EGL_NO_DEVICE_EXT                                   ((EGLDeviceEXT)0)
+#endif
+
+#ifndef EGL_EXT_device_drm
+#define EGL_EXT_device_drm 1
+#define EGL_DRM_DEVICE_FILE_EXT                             0x3233
+#endif
+
+#ifndef EGL_EXT_device_drm_render_node
+#define EGL_EXT_device_drm_render_node 1
+#define EGL_DRM_RENDER_NODE_FILE_EXT                        0x3377
+#endif
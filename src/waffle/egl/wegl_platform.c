@@ -24,9 +24,14 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <dlfcn.h>
+#include <stdlib.h>
 
 #include "wcore_error.h"
+
+#include "linux_device.h"
+
 #include "wegl_platform.h"
+#include "wegl_util.h"
 
 
 #ifdef WAFFLE_HAS_ANDROID
@@ -86,6 +91,8 @@ wegl_platform_init(struct wegl_platform *self)
     }
 
     RETRIEVE_EGL_SYMBOL(eglMakeCurrent);
+    RETRIEVE_EGL_SYMBOL(eglGetCurrentContext);
+    RETRIEVE_EGL_SYMBOL(eglGetCurrentSurface);
     RETRIEVE_EGL_SYMBOL(eglGetProcAddress);
 
     // display
@@ -102,6 +109,7 @@ wegl_platform_init(struct wegl_platform *self)
     RETRIEVE_EGL_SYMBOL(eglBindAPI);
     RETRIEVE_EGL_SYMBOL(eglCreateContext);
     RETRIEVE_EGL_SYMBOL(eglDestroyContext);
+    RETRIEVE_EGL_SYMBOL(eglQueryContext);
 
     // window
     RETRIEVE_EGL_SYMBOL(eglGetConfigAttrib);
@@ -111,8 +119,90 @@ wegl_platform_init(struct wegl_platform *self)
 
 #undef RETRIEVE_EGL_SYMBOL
 
+    // Extension functions are optional. Whether the display supports them is
+    // checked when they are needed.
+    self->eglCreateImageKHR = (void*) self->eglGetProcAddress("eglCreateImageKHR");
+    self->eglDestroyImageKHR = (void*) self->eglGetProcAddress("eglDestroyImageKHR");
+    self->glEGLImageTargetTexture2DOES = (void*) self->eglGetProcAddress("glEGLImageTargetTexture2DOES");
+    self->eglExportDMABUFImageQueryMESA = (void*) self->eglGetProcAddress("eglExportDMABUFImageQueryMESA");
+    self->eglExportDMABUFImageMESA = (void*) self->eglGetProcAddress("eglExportDMABUFImageMESA");
+    self->eglCreateSyncKHR = (void*) self->eglGetProcAddress("eglCreateSyncKHR");
+    self->eglDestroySyncKHR = (void*) self->eglGetProcAddress("eglDestroySyncKHR");
+    self->eglClientWaitSyncKHR = (void*) self->eglGetProcAddress("eglClientWaitSyncKHR");
+    self->eglWaitSyncKHR = (void*) self->eglGetProcAddress("eglWaitSyncKHR");
+    self->eglDupNativeFenceFDANDROID = (void*) self->eglGetProcAddress("eglDupNativeFenceFDANDROID");
+    self->eglQueryDevicesEXT = (void*) self->eglGetProcAddress("eglQueryDevicesEXT");
+    self->eglQueryDeviceStringEXT = (void*) self->eglGetProcAddress("eglQueryDeviceStringEXT");
+
 error:
     // On failure the caller of wegl_platform_init will trigger it's own
     // destruction which will execute wegl_platform_teardown.
     return ok;
 }
+
+bool
+wegl_platform_enumerate_devices(struct wcore_platform *wc_self,
+                                struct waffle_device_info devices[],
+                                int32_t max_devices,
+                                int32_t *num_devices)
+{
+    struct wegl_platform *self = wegl_platform(wc_self);
+    const char *extensions;
+    EGLDeviceEXT *egl_devices;
+    EGLint num_egl_devices = 0;
+
+    extensions = self->eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (!extensions ||
+        !waffle_is_extension_in_string(extensions,
+                                       "EGL_EXT_device_enumeration") ||
+        !self->eglQueryDevicesEXT || !self->eglQueryDeviceStringEXT) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "EGL_EXT_device_enumeration is unsupported");
+        return false;
+    }
+
+    if (!self->eglQueryDevicesEXT(0, NULL, &num_egl_devices)) {
+        wegl_emit_error(self, "eglQueryDevicesEXT");
+        return false;
+    }
+
+    if (num_egl_devices == 0)
+        return true;
+
+    egl_devices = wcore_calloc(num_egl_devices * sizeof(*egl_devices));
+    if (!egl_devices)
+        return false;
+
+    if (!self->eglQueryDevicesEXT(num_egl_devices, egl_devices,
+                                  &num_egl_devices)) {
+        wegl_emit_error(self, "eglQueryDevicesEXT");
+        free(egl_devices);
+        return false;
+    }
+
+    for (EGLint i = 0; i < num_egl_devices; ++i) {
+        const char *node = NULL;
+
+        extensions = self->eglQueryDeviceStringEXT(egl_devices[i],
+                                                   EGL_EXTENSIONS);
+        if (!extensions)
+            continue;
+
+        // Prefer the render node, which needs no DRM master.
+        if (waffle_is_extension_in_string(extensions,
+                                          "EGL_EXT_device_drm_render_node"))
+            node = self->eglQueryDeviceStringEXT(egl_devices[i],
+                                                 EGL_DRM_RENDER_NODE_FILE_EXT);
+        if (!node && waffle_is_extension_in_string(extensions,
+                                                   "EGL_EXT_device_drm"))
+            node = self->eglQueryDeviceStringEXT(egl_devices[i],
+                                                 EGL_DRM_DEVICE_FILE_EXT);
+
+        // Software devices have no node.
+        if (node)
+            linux_device_report(devices, max_devices, num_devices, node);
+    }
+
+    free(egl_devices);
+    return true;
+}
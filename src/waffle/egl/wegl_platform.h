@@ -25,11 +25,11 @@
 
 #pragma once
 
-#include <EGL/egl.h>
-
 #include "wcore_platform.h"
 #include "wcore_util.h"
 
+#include "wegl_imports.h"
+
 struct wegl_platform {
     struct wcore_platform wcore;
 
@@ -49,6 +49,8 @@ struct wegl_platform {
 
     EGLBoolean (*eglMakeCurrent)(EGLDisplay dpy, EGLSurface draw,
                                  EGLSurface read, EGLContext ctx);
+    EGLContext (*eglGetCurrentContext)(void);
+    EGLSurface (*eglGetCurrentSurface)(EGLint readdraw);
     __eglMustCastToProperFunctionPointerType
        (*eglGetProcAddress)(const char *procname);
 
@@ -70,6 +72,8 @@ struct wegl_platform {
                                    EGLContext share_context,
                                    const EGLint *attrib_list);
     EGLBoolean (*eglDestroyContext)(EGLDisplay dpy, EGLContext ctx);
+    EGLBoolean (*eglQueryContext)(EGLDisplay dpy, EGLContext ctx,
+                                  EGLint attribute, EGLint *value);
 
     // window
     EGLBoolean (*eglGetConfigAttrib)(EGLDisplay dpy, EGLConfig config,
@@ -79,6 +83,34 @@ struct wegl_platform {
                                          const EGLint *attrib_list);
     EGLBoolean (*eglDestroySurface)(EGLDisplay dpy, EGLSurface surface);
     EGLBoolean (*eglSwapBuffers)(EGLDisplay dpy, EGLSurface surface);
+
+    // image, from eglGetProcAddress; null if unavailable
+    EGLImageKHR (*eglCreateImageKHR)(EGLDisplay dpy, EGLContext ctx,
+                                     EGLenum target, EGLClientBuffer buffer,
+                                     const EGLint *attrib_list);
+    EGLBoolean (*eglDestroyImageKHR)(EGLDisplay dpy, EGLImageKHR image);
+    void (*glEGLImageTargetTexture2DOES)(unsigned target, void *image);
+    EGLBoolean (*eglExportDMABUFImageQueryMESA)(EGLDisplay dpy,
+                                                EGLImageKHR image,
+                                                int *fourcc, int *num_planes,
+                                                uint64_t *modifiers);
+    EGLBoolean (*eglExportDMABUFImageMESA)(EGLDisplay dpy, EGLImageKHR image,
+                                           int *fds, EGLint *strides,
+                                           EGLint *offsets);
+
+    // fence, from eglGetProcAddress; null if unavailable
+    EGLSyncKHR (*eglCreateSyncKHR)(EGLDisplay dpy, EGLenum type,
+                                   const EGLint *attrib_list);
+    EGLBoolean (*eglDestroySyncKHR)(EGLDisplay dpy, EGLSyncKHR sync);
+    EGLint (*eglClientWaitSyncKHR)(EGLDisplay dpy, EGLSyncKHR sync,
+                                   EGLint flags, EGLTimeKHR timeout);
+    EGLint (*eglWaitSyncKHR)(EGLDisplay dpy, EGLSyncKHR sync, EGLint flags);
+    EGLint (*eglDupNativeFenceFDANDROID)(EGLDisplay dpy, EGLSyncKHR sync);
+
+    // device, from eglGetProcAddress; null if unavailable
+    EGLBoolean (*eglQueryDevicesEXT)(EGLint max_devices, EGLDeviceEXT *devices,
+                                     EGLint *num_devices);
+    const char * (*eglQueryDeviceStringEXT)(EGLDeviceEXT device, EGLint name);
 };
 
 DEFINE_CONTAINER_CAST_FUNC(wegl_platform,
@@ -91,3 +123,10 @@ wegl_platform_teardown(struct wegl_platform *self);
 
 bool
 wegl_platform_init(struct wegl_platform *self);
+
+/// List the DRM devices of EGL_EXT_device_enumeration.
+bool
+wegl_platform_enumerate_devices(struct wcore_platform *wc_self,
+                                struct waffle_device_info devices[],
+                                int32_t max_devices,
+                                int32_t *num_devices);
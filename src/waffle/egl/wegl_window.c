@@ -38,34 +38,21 @@ wegl_window_init(struct wegl_window *window,
                  intptr_t native_window)
 {
     struct wegl_config *config = wegl_config(wc_config);
-    struct wegl_display *dpy = wegl_display(wc_config->display);
-    struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
-    EGLint egl_render_buffer;
     bool ok;
 
     ok = wcore_window_init(&window->wcore, wc_config);
     if (!ok)
         goto fail;
 
+    window->egl_config = config->egl;
     if (config->wcore.attrs.double_buffered)
-        egl_render_buffer = EGL_BACK_BUFFER;
+        window->egl_render_buffer = EGL_BACK_BUFFER;
     else
-        egl_render_buffer = EGL_SINGLE_BUFFER;
-
-    EGLint attrib_list[] = {
-        EGL_RENDER_BUFFER, egl_render_buffer,
-        EGL_NONE,
-    };
+        window->egl_render_buffer = EGL_SINGLE_BUFFER;
 
-    window->egl = plat->eglCreateWindowSurface(dpy->egl,
-                                               config->egl,
-                                               (EGLNativeWindowType)
-                                                   native_window,
-                                               attrib_list);
-    if (!window->egl) {
-        wegl_emit_error(plat, "eglCreateWindowSurface");
+    window->egl = wegl_window_create_surface(window, native_window);
+    if (!window->egl)
         goto fail;
-    }
 
     return true;
 
@@ -74,13 +61,44 @@ fail:
     return false;
 }
 
-bool
-wegl_window_teardown(struct wegl_window *window)
+EGLSurface
+wegl_window_create_surface(struct wegl_window *window,
+                           intptr_t native_window)
 {
     struct wegl_display *dpy = wegl_display(window->wcore.display);
     struct wegl_platform *plat = wegl_platform(dpy->wcore.platform);
+    EGLSurface surface;
+
+    EGLint attrib_list[] = {
+        EGL_RENDER_BUFFER, window->egl_render_buffer,
+        EGL_NONE,
+    };
+
+    surface = plat->eglCreateWindowSurface(dpy->egl,
+                                           window->egl_config,
+                                           (EGLNativeWindowType)
+                                               native_window,
+                                           attrib_list);
+    if (!surface)
+        wegl_emit_error(plat, "eglCreateWindowSurface");
+
+    return surface;
+}
+
+bool
+wegl_window_teardown(struct wegl_window *window)
+{
+    struct wegl_display *dpy;
+    struct wegl_platform *plat;
     bool result = true;
 
+    // The window failed creation before wegl_window_init().
+    if (!window->wcore.display)
+        return result;
+
+    dpy = wegl_display(window->wcore.display);
+    plat = wegl_platform(dpy->wcore.platform);
+
     if (window->egl) {
         bool ok = plat->eglDestroySurface(dpy->egl, window->egl);
         if (!ok) {
@@ -38,6 +38,10 @@ struct wegl_display;
 struct wegl_window {
     struct wcore_window wcore;
     EGLSurface egl;
+
+    // For wegl_window_create_surface().
+    EGLConfig egl_config;
+    EGLint egl_render_buffer;
 };
 
 DEFINE_CONTAINER_CAST_FUNC(wegl_window,
@@ -53,5 +57,13 @@ wegl_window_init(struct wegl_window *window,
 bool
 wegl_window_teardown(struct wegl_window *window);
 
+/// @brief Create another surface with the window's config.
+///
+/// The caller owns the result, for platforms that replace the window's
+/// native window.
+EGLSurface
+wegl_window_create_surface(struct wegl_window *window,
+                           intptr_t native_window);
+
 bool
 wegl_window_swap_buffers(struct wcore_window *wc_window);
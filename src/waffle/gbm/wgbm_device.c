@@ -0,0 +1,306 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define _POSIX_C_SOURCE 200809L // strdup
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <libudev.h>
+
+#include "threads.h"
+
+#include "wcore_error.h"
+#include "wcore_util.h"
+
+#include "linux_device.h"
+
+#include "wgbm_device.h"
+
+struct wgbm_node {
+    char *devnode;
+
+    /// Syspath of the node's parent, which is the same for the render and
+    /// card nodes of a GPU. Null if the node has no parent.
+    char *parent;
+};
+
+struct wgbm_node_list {
+    struct wgbm_node *nodes;
+    int32_t count;
+};
+
+struct wgbm_devices {
+    mtx_t mutex;
+
+    struct udev *udev;
+
+    /// Null if udev cannot monitor the drm subsystem.
+    struct udev_monitor *monitor;
+
+    /// False until the first scan, and after a hotplug event.
+    bool valid;
+
+    struct wgbm_node_list render;
+    struct wgbm_node_list card;
+};
+
+static void
+wgbm_node_list_clear(struct wgbm_node_list *list)
+{
+    for (int32_t i = 0; i < list->count; ++i) {
+        free(list->nodes[i].devnode);
+        free(list->nodes[i].parent);
+    }
+
+    free(list->nodes);
+    list->nodes = NULL;
+    list->count = 0;
+}
+
+static bool
+wgbm_node_list_scan(struct wgbm_node_list *list,
+                    struct udev *ud,
+                    const char *pattern)
+{
+    struct udev_enumerate *en;
+    struct udev_list_entry *entry;
+    struct udev_device *device;
+    struct udev_device *parent;
+    const char *filename;
+    const char *parent_path;
+    struct wgbm_node *nodes;
+    bool ok = true;
+
+    en = udev_enumerate_new(ud);
+    if (!en)
+        return false;
+
+    udev_enumerate_add_match_subsystem(en, "drm");
+    udev_enumerate_add_match_sysname(en, pattern);
+    udev_enumerate_scan_devices(en);
+
+    udev_list_entry_foreach(entry, udev_enumerate_get_list_entry(en)) {
+        device = udev_device_new_from_syspath(ud,
+                                              udev_list_entry_get_name(entry));
+        if (!device)
+            continue;
+
+        filename = udev_device_get_devnode(device);
+        if (filename) {
+            // The parent belongs to device, so it needs no unref.
+            parent = udev_device_get_parent(device);
+            parent_path = parent ? udev_device_get_syspath(parent) : NULL;
+
+            nodes = wcore_realloc(list->nodes,
+                                  (list->count + 1) * sizeof(*nodes));
+            if (nodes) {
+                list->nodes = nodes;
+                nodes[list->count].devnode = strdup(filename);
+                nodes[list->count].parent =
+                    parent_path ? strdup(parent_path) : NULL;
+                list->count++;
+            }
+
+            if (!nodes || !nodes[list->count - 1].devnode ||
+                (parent_path && !nodes[list->count - 1].parent)) {
+                udev_device_unref(device);
+                ok = false;
+                break;
+            }
+        }
+
+        udev_device_unref(device);
+    }
+
+    udev_enumerate_unref(en);
+    return ok;
+}
+
+/// Rescan if needed. Called with the mutex held.
+static bool
+wgbm_devices_update(struct wgbm_devices *self)
+{
+    struct udev_device *device;
+
+    if (!self->monitor) {
+        self->valid = false;
+    } else {
+        // The monitor's socket does not block, so this drains the events
+        // queued since the last call.
+        while ((device = udev_monitor_receive_device(self->monitor))) {
+            udev_device_unref(device);
+            self->valid = false;
+        }
+    }
+
+    if (self->valid)
+        return true;
+
+    wgbm_node_list_clear(&self->render);
+    wgbm_node_list_clear(&self->card);
+
+    if (!wgbm_node_list_scan(&self->render, self->udev, "renderD[0-9]*") ||
+        !wgbm_node_list_scan(&self->card, self->udev, "card[0-9]*")) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "failed to scan drm devices");
+        return false;
+    }
+
+    self->valid = true;
+    return true;
+}
+
+struct wgbm_devices*
+wgbm_devices_create(void)
+{
+    struct wgbm_devices *self;
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    if (mtx_init(&self->mutex, mtx_plain) != thrd_success) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "mtx_init failed");
+        free(self);
+        return NULL;
+    }
+
+    self->udev = udev_new();
+    if (!self->udev) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "udev_new failed");
+        wgbm_devices_destroy(self);
+        return NULL;
+    }
+
+    // Listen before the first scan, so that no hotplug event is missed.
+    self->monitor = udev_monitor_new_from_netlink(self->udev, "udev");
+    if (self->monitor &&
+        (udev_monitor_filter_add_match_subsystem_devtype(self->monitor,
+                                                         "drm", NULL) < 0 ||
+         udev_monitor_enable_receiving(self->monitor) < 0)) {
+        udev_monitor_unref(self->monitor);
+        self->monitor = NULL;
+    }
+
+    return self;
+}
+
+void
+wgbm_devices_destroy(struct wgbm_devices *self)
+{
+    if (!self)
+        return;
+
+    wgbm_node_list_clear(&self->render);
+    wgbm_node_list_clear(&self->card);
+
+    if (self->monitor)
+        udev_monitor_unref(self->monitor);
+    if (self->udev)
+        udev_unref(self->udev);
+
+    mtx_destroy(&self->mutex);
+    free(self);
+}
+
+static int
+wgbm_node_list_open(const struct wgbm_node_list *list)
+{
+    int fd;
+
+    for (int32_t i = 0; i < list->count; ++i) {
+        fd = open(list->nodes[i].devnode, O_RDWR | O_CLOEXEC);
+        if (fd >= 0)
+            return fd;
+    }
+
+    return -1;
+}
+
+int
+wgbm_devices_open_default(struct wgbm_devices *self, bool card_only)
+{
+    int fd = -1;
+
+    mtx_lock(&self->mutex);
+
+    if (wgbm_devices_update(self)) {
+        if (!card_only)
+            fd = wgbm_node_list_open(&self->render);
+        if (fd < 0)
+            fd = wgbm_node_list_open(&self->card);
+    }
+
+    mtx_unlock(&self->mutex);
+    return fd;
+}
+
+/// True if a node of @a list has the same parent as @a node.
+static bool
+wgbm_node_list_has_parent(const struct wgbm_node_list *list,
+                          const struct wgbm_node *node)
+{
+    if (!node->parent)
+        return false;
+
+    for (int32_t i = 0; i < list->count; ++i) {
+        if (list->nodes[i].parent &&
+            strcmp(list->nodes[i].parent, node->parent) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+bool
+wgbm_devices_enumerate(struct wgbm_devices *self,
+                       struct waffle_device_info devices[],
+                       int32_t max_devices,
+                       int32_t *num_devices)
+{
+    bool ok;
+
+    mtx_lock(&self->mutex);
+
+    ok = wgbm_devices_update(self);
+    if (ok) {
+        for (int32_t i = 0; i < self->render.count; ++i)
+            linux_device_report(devices, max_devices, num_devices,
+                                self->render.nodes[i].devnode);
+
+        // A GPU with a render node is already listed.
+        for (int32_t i = 0; i < self->card.count; ++i) {
+            if (wgbm_node_list_has_parent(&self->render, &self->card.nodes[i]))
+                continue;
+            linux_device_report(devices, max_devices, num_devices,
+                                self->card.nodes[i].devnode);
+        }
+    }
+
+    mtx_unlock(&self->mutex);
+    return ok;
+}
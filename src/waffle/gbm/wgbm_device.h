@@ -0,0 +1,61 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct waffle_device_info;
+struct wgbm_devices;
+
+/// @brief A cache of the drm subsystem's device nodes.
+///
+/// The first use scans udev. Later uses rescan only after a udev monitor
+/// reports a hotplug event, or every time if the monitor is unavailable.
+/// The cache is safe to use from several threads.
+struct wgbm_devices*
+wgbm_devices_create(void);
+
+void
+wgbm_devices_destroy(struct wgbm_devices *self);
+
+/// @brief Open the first device node that can be opened.
+///
+/// Try render nodes and then card nodes, or only card nodes if @a card_only.
+/// Return the fd, or -1.
+int
+wgbm_devices_open_default(struct wgbm_devices *self, bool card_only);
+
+/// @brief List each GPU once.
+///
+/// A GPU is listed by its render node, or by its card node if it has none,
+/// such as a display controller without a renderer. The render nodes come
+/// first.
+bool
+wgbm_devices_enumerate(struct wgbm_devices *self,
+                       struct waffle_device_info devices[],
+                       int32_t max_devices,
+                       int32_t *num_devices);
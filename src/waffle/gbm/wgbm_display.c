@@ -27,9 +27,9 @@
 
 #include <dlfcn.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
-#include <libudev.h>
 #include <fcntl.h>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -37,25 +37,28 @@
 
 #include "wcore_error.h"
 
+#include "wgbm_device.h"
 #include "wgbm_display.h"
+#include "wgbm_kms.h"
 #include "wgbm_platform.h"
 
 bool
 wgbm_display_destroy(struct wcore_display *wc_self)
 {
     struct wgbm_display *self = wgbm_display(wc_self);
-    struct wcore_platform *wc_plat = wc_self->platform;
-    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+    struct wgbm_platform *plat;
     bool ok = true;
     int fd;
 
     if (!self)
         return ok;
 
+    plat = wgbm_platform(wegl_platform(wc_self->platform));
 
     ok &= wegl_display_teardown(&self->wegl);
+    wgbm_kms_destroy(self->kms);
 
-    if (self->gbm_device) {
+    if (self->gbm_device && !self->adopted) {
         fd = plat->gbm_device_get_fd(self->gbm_device);
         plat->gbm_device_destroy(self->gbm_device);
         close(fd);
@@ -65,54 +68,25 @@ wgbm_display_destroy(struct wcore_display *wc_self)
     return ok;
 }
 
-int
-wgbm_get_default_fd_for_pattern(const char *pattern)
+bool
+wgbm_enumerate_devices(struct wcore_platform *wc_plat,
+                       struct waffle_device_info devices[],
+                       int32_t max_devices,
+                       int32_t *num_devices)
 {
-    struct udev *ud;
-    struct udev_enumerate *en;
-    struct udev_list_entry *devices, *entry;
-    const char *path, *filename;
-    struct udev_device *device;
-    int fd;
-
-    ud = udev_new();
-    en = udev_enumerate_new(ud);
-    udev_enumerate_add_match_subsystem(en, "drm");
-    udev_enumerate_add_match_sysname(en, pattern);
-    udev_enumerate_scan_devices(en);
-    devices = udev_enumerate_get_list_entry(en);
-
-    udev_list_entry_foreach(entry, devices) {
-        path = udev_list_entry_get_name(entry);
-        device = udev_device_new_from_syspath(ud, path);
-        filename = udev_device_get_devnode(device);
-        fd = open(filename, O_RDWR | O_CLOEXEC);
-        udev_device_unref(device);
-        if (fd >= 0) {
-            udev_enumerate_unref(en);
-            udev_unref(ud);
-            return fd;
-        }
-    }
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
 
-    udev_enumerate_unref(en);
-    udev_unref(ud);
-    return -1;
+    return wgbm_devices_enumerate(plat->devices, devices, max_devices,
+                                  num_devices);
 }
 
-static int
-wgbm_get_default_fd(void)
+/// True if the environment variable WAFFLE_GBM_KMS requests scanout.
+static bool
+wgbm_display_want_kms(void)
 {
-    int fd;
+    const char *env = getenv("WAFFLE_GBM_KMS");
 
-    // Try opening render node first
-    fd = wgbm_get_default_fd_for_pattern("renderD[0-9]*");
-    if (fd >= 0)
-        return fd;
-
-    // If render nodes are not supported, then fall back to the card
-    fd = wgbm_get_default_fd_for_pattern("card[0-9]*");
-    return fd;
+    return env && strcmp(env, "0") != 0;
 }
 
 struct wcore_display*
@@ -140,7 +114,9 @@ wgbm_display_connect(struct wcore_platform *wc_plat,
             goto error;
         }
     } else {
-        fd = wgbm_get_default_fd();
+        // Render nodes cannot modeset.
+        fd = wgbm_devices_open_default(plat->devices,
+                                       wgbm_display_want_kms());
         if (fd < 0) {
             wcore_errorf(WAFFLE_ERROR_UNKNOWN, "open drm file for gbm failed");
             goto error;
@@ -151,9 +127,51 @@ wgbm_display_connect(struct wcore_platform *wc_plat,
     self->gbm_device = plat->gbm_create_device(fd);
     if (!self->gbm_device) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "gbm_create_device failed");
+        close(fd);
         goto error;
     }
 
+    // Initialize EGL first, because wgbm_display_destroy() needs the
+    // platform that wegl_display_init() records.
+    ok = wegl_display_init(&self->wegl, wc_plat, (intptr_t) self->gbm_device);
+    if (!ok)
+        goto error;
+
+    if (wgbm_display_want_kms()) {
+        self->kms = wgbm_kms_create(fd);
+        if (!self->kms)
+            goto error;
+    }
+
+    return &self->wegl.wcore;
+
+error:
+    wgbm_display_destroy(&self->wegl.wcore);
+    return NULL;
+}
+
+struct wcore_display*
+wgbm_display_adopt_native(struct wcore_platform *wc_plat,
+                          union waffle_native_display *native)
+{
+    struct wgbm_display *self;
+    bool ok = true;
+
+    if (!native->gbm || !native->gbm->gbm_device) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "native->gbm->gbm_device is null");
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (self == NULL)
+        return NULL;
+
+    dlopen("libglapi.so.0", RTLD_LAZY | RTLD_GLOBAL);
+    self->gbm_device = native->gbm->gbm_device;
+    self->adopted = true;
+
+    self->wegl.adopted = true;
     ok = wegl_display_init(&self->wegl, wc_plat, (intptr_t) self->gbm_device);
     if (!ok)
         goto error;
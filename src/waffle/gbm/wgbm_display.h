@@ -34,9 +34,17 @@
 
 struct wcore_platform;
 struct gbm_device;
+struct wgbm_kms;
 
 struct wgbm_display {
     struct gbm_device *gbm_device;
+
+    /// The device and its fd belong to the application.
+    bool adopted;
+
+    /// Set if the environment variable WAFFLE_GBM_KMS enables scanout.
+    struct wgbm_kms *kms;
+
     struct wegl_display wegl;
 };
 
@@ -56,6 +64,10 @@ struct wcore_display*
 wgbm_display_connect(struct wcore_platform *wc_plat,
                      const char *name);
 
+struct wcore_display*
+wgbm_display_adopt_native(struct wcore_platform *wc_plat,
+                          union waffle_native_display *native);
+
 bool
 wgbm_display_destroy(struct wcore_display *wc_self);
 
@@ -66,5 +78,9 @@ void
 wgbm_display_fill_native(struct wgbm_display *self,
                          struct waffle_gbm_display *n_dpy);
 
-int
-wgbm_get_default_fd_for_pattern(const char *pattern);
+/// List the render nodes, then the card nodes, of the drm subsystem.
+bool
+wgbm_enumerate_devices(struct wcore_platform *wc_plat,
+                       struct waffle_device_info devices[],
+                       int32_t max_devices,
+                       int32_t *num_devices);
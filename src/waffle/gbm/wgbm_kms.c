@@ -0,0 +1,572 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <drm_fourcc.h>
+#include <gbm.h>
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+
+#include "wcore_error.h"
+#include "wcore_util.h"
+
+#include "wgbm_kms.h"
+#include "wgbm_platform.h"
+
+/// Attached to each gbm_bo that has been scanned out.
+struct wgbm_kms_fb {
+    int fd;
+    uint32_t fb_id;
+};
+
+static uint32_t
+wgbm_kms_get_prop_id(int fd,
+                     uint32_t object_id,
+                     uint32_t object_type,
+                     const char *name)
+{
+    drmModeObjectPropertiesPtr props;
+    uint32_t prop_id = 0;
+
+    props = drmModeObjectGetProperties(fd, object_id, object_type);
+    if (!props)
+        return 0;
+
+    for (uint32_t i = 0; i < props->count_props && !prop_id; ++i) {
+        drmModePropertyPtr prop = drmModeGetProperty(fd, props->props[i]);
+        if (!prop)
+            continue;
+
+        if (strcmp(prop->name, name) == 0)
+            prop_id = prop->prop_id;
+
+        drmModeFreeProperty(prop);
+    }
+
+    drmModeFreeObjectProperties(props);
+    return prop_id;
+}
+
+static bool
+wgbm_kms_plane_is_primary(int fd, uint32_t plane_id)
+{
+    drmModeObjectPropertiesPtr props;
+    bool is_primary = false;
+
+    props = drmModeObjectGetProperties(fd, plane_id, DRM_MODE_OBJECT_PLANE);
+    if (!props)
+        return false;
+
+    for (uint32_t i = 0; i < props->count_props; ++i) {
+        drmModePropertyPtr prop = drmModeGetProperty(fd, props->props[i]);
+        if (!prop)
+            continue;
+
+        if (strcmp(prop->name, "type") == 0)
+            is_primary = props->prop_values[i] == DRM_PLANE_TYPE_PRIMARY;
+
+        drmModeFreeProperty(prop);
+    }
+
+    drmModeFreeObjectProperties(props);
+    return is_primary;
+}
+
+static bool
+wgbm_kms_choose_connector(struct wgbm_kms *self, drmModeResPtr res)
+{
+    for (int i = 0; i < res->count_connectors; ++i) {
+        drmModeConnectorPtr conn;
+
+        conn = drmModeGetConnector(self->fd, res->connectors[i]);
+        if (!conn)
+            continue;
+
+        if (conn->connection != DRM_MODE_CONNECTED || conn->count_modes == 0) {
+            drmModeFreeConnector(conn);
+            continue;
+        }
+
+        self->connector_id = conn->connector_id;
+        self->mode = conn->modes[0];
+
+        for (int j = 0; j < conn->count_modes; ++j) {
+            if (conn->modes[j].type & DRM_MODE_TYPE_PREFERRED) {
+                self->mode = conn->modes[j];
+                break;
+            }
+        }
+
+        // Prefer the CRTC that already drives the connector, to avoid a
+        // needless modeset of other outputs.
+        for (int j = -1; j < conn->count_encoders && !self->crtc_id; ++j) {
+            uint32_t encoder_id = j < 0 ? conn->encoder_id : conn->encoders[j];
+            drmModeEncoderPtr enc;
+
+            if (!encoder_id)
+                continue;
+
+            enc = drmModeGetEncoder(self->fd, encoder_id);
+            if (!enc)
+                continue;
+
+            if (j < 0 && enc->crtc_id) {
+                self->crtc_id = enc->crtc_id;
+            }
+            else if (j >= 0) {
+                for (int k = 0; k < res->count_crtcs; ++k) {
+                    if (enc->possible_crtcs & (1u << k)) {
+                        self->crtc_id = res->crtcs[k];
+                        break;
+                    }
+                }
+            }
+
+            drmModeFreeEncoder(enc);
+        }
+
+        drmModeFreeConnector(conn);
+
+        if (self->crtc_id)
+            return true;
+
+        self->connector_id = 0;
+    }
+
+    wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                 "found no connected KMS connector with a usable CRTC");
+    return false;
+}
+
+static bool
+wgbm_kms_choose_plane(struct wgbm_kms *self, drmModeResPtr res)
+{
+    drmModePlaneResPtr plane_res;
+    uint32_t crtc_bit = 0;
+
+    for (int i = 0; i < res->count_crtcs; ++i) {
+        if (res->crtcs[i] == self->crtc_id)
+            crtc_bit = 1u << i;
+    }
+
+    plane_res = drmModeGetPlaneResources(self->fd);
+    if (!plane_res) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "drmModeGetPlaneResources failed");
+        return false;
+    }
+
+    for (uint32_t i = 0; i < plane_res->count_planes && !self->plane_id; ++i) {
+        drmModePlanePtr plane = drmModeGetPlane(self->fd, plane_res->planes[i]);
+        if (!plane)
+            continue;
+
+        if ((plane->possible_crtcs & crtc_bit) &&
+            wgbm_kms_plane_is_primary(self->fd, plane->plane_id))
+            self->plane_id = plane->plane_id;
+
+        drmModeFreePlane(plane);
+    }
+
+    drmModeFreePlaneResources(plane_res);
+
+    if (!self->plane_id) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "found no primary plane for CRTC %u", self->crtc_id);
+        return false;
+    }
+
+    return true;
+}
+
+static bool
+wgbm_kms_get_props(struct wgbm_kms *self)
+{
+    const struct {
+        uint32_t *id;
+        uint32_t object_id;
+        uint32_t object_type;
+        const char *name;
+    } props[] = {
+#define CONNECTOR_PROP(field, name) \
+        { &self->connector_props.field, self->connector_id, \
+          DRM_MODE_OBJECT_CONNECTOR, name }
+#define CRTC_PROP(field, name) \
+        { &self->crtc_props.field, self->crtc_id, \
+          DRM_MODE_OBJECT_CRTC, name }
+#define PLANE_PROP(field, name) \
+        { &self->plane_props.field, self->plane_id, \
+          DRM_MODE_OBJECT_PLANE, name }
+        CONNECTOR_PROP(crtc_id, "CRTC_ID"),
+        CRTC_PROP(mode_id, "MODE_ID"),
+        CRTC_PROP(active, "ACTIVE"),
+        PLANE_PROP(fb_id, "FB_ID"),
+        PLANE_PROP(crtc_id, "CRTC_ID"),
+        PLANE_PROP(src_x, "SRC_X"),
+        PLANE_PROP(src_y, "SRC_Y"),
+        PLANE_PROP(src_w, "SRC_W"),
+        PLANE_PROP(src_h, "SRC_H"),
+        PLANE_PROP(crtc_x, "CRTC_X"),
+        PLANE_PROP(crtc_y, "CRTC_Y"),
+        PLANE_PROP(crtc_w, "CRTC_W"),
+        PLANE_PROP(crtc_h, "CRTC_H"),
+#undef CONNECTOR_PROP
+#undef CRTC_PROP
+#undef PLANE_PROP
+    };
+
+    for (size_t i = 0; i < sizeof(props) / sizeof(props[0]); ++i) {
+        *props[i].id = wgbm_kms_get_prop_id(self->fd, props[i].object_id,
+                                            props[i].object_type,
+                                            props[i].name);
+        if (!*props[i].id) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "KMS object %u lacks property %s",
+                         props[i].object_id, props[i].name);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+struct wgbm_kms*
+wgbm_kms_create(int fd)
+{
+    struct wgbm_kms *self;
+    drmModeResPtr res = NULL;
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    self->fd = fd;
+    self->needs_modeset = true;
+
+    if (drmSetClientCap(fd, DRM_CLIENT_CAP_UNIVERSAL_PLANES, 1) ||
+        drmSetClientCap(fd, DRM_CLIENT_CAP_ATOMIC, 1)) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "DRM device does not support atomic modesetting");
+        goto error;
+    }
+
+    res = drmModeGetResources(fd);
+    if (!res) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "drmModeGetResources failed; is this a render node?");
+        goto error;
+    }
+
+    if (!wgbm_kms_choose_connector(self, res) ||
+        !wgbm_kms_choose_plane(self, res) ||
+        !wgbm_kms_get_props(self))
+        goto error;
+
+    if (drmModeCreatePropertyBlob(fd, &self->mode, sizeof(self->mode),
+                                  &self->mode_blob_id)) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "drmModeCreatePropertyBlob failed");
+        goto error;
+    }
+
+    drmModeFreeResources(res);
+    return self;
+
+error:
+    if (res)
+        drmModeFreeResources(res);
+    free(self);
+    return NULL;
+}
+
+void
+wgbm_kms_destroy(struct wgbm_kms *self)
+{
+    if (!self)
+        return;
+
+    wgbm_kms_disable(self);
+
+    if (self->mode_blob_id)
+        drmModeDestroyPropertyBlob(self->fd, self->mode_blob_id);
+
+    free(self);
+}
+
+bool
+wgbm_kms_disable(struct wgbm_kms *self)
+{
+    drmModeAtomicReqPtr req;
+    int ret;
+
+    if (!wgbm_kms_wait_flip(self))
+        return false;
+
+    if (self->needs_modeset)
+        return true;
+
+    req = drmModeAtomicAlloc();
+    if (!req) {
+        wcore_error(WAFFLE_ERROR_BAD_ALLOC);
+        return false;
+    }
+
+    drmModeAtomicAddProperty(req, self->plane_id,
+                             self->plane_props.fb_id, 0);
+    drmModeAtomicAddProperty(req, self->plane_id,
+                             self->plane_props.crtc_id, 0);
+    drmModeAtomicAddProperty(req, self->connector_id,
+                             self->connector_props.crtc_id, 0);
+    drmModeAtomicAddProperty(req, self->crtc_id,
+                             self->crtc_props.mode_id, 0);
+    drmModeAtomicAddProperty(req, self->crtc_id,
+                             self->crtc_props.active, 0);
+
+    // Block, so that the framebuffer is off screen on return.
+    ret = drmModeAtomicCommit(self->fd, req,
+                              DRM_MODE_ATOMIC_ALLOW_MODESET, NULL);
+    drmModeAtomicFree(req);
+
+    if (ret) {
+        wcore_error_errno("drmModeAtomicCommit failed");
+        return false;
+    }
+
+    self->needs_modeset = true;
+    return true;
+}
+
+static void
+wgbm_kms_destroy_fb(struct gbm_bo *bo, void *data)
+{
+    struct wgbm_kms_fb *fb = data;
+
+    drmModeRmFB(fb->fd, fb->fb_id);
+    free(fb);
+}
+
+/// Scanout ignores alpha, and planes often accept only the X variants.
+static uint32_t
+wgbm_kms_get_fb_format(uint32_t format)
+{
+    switch (format) {
+        case GBM_FORMAT_ARGB8888:
+            return GBM_FORMAT_XRGB8888;
+        case GBM_FORMAT_ABGR8888:
+            return GBM_FORMAT_XBGR8888;
+        case GBM_FORMAT_ARGB2101010:
+            return GBM_FORMAT_XRGB2101010;
+        default:
+            return format;
+    }
+}
+
+bool
+wgbm_kms_get_fb(struct wgbm_kms *self,
+                struct wgbm_platform *plat,
+                struct gbm_bo *bo,
+                uint32_t *fb_id)
+{
+    struct wgbm_kms_fb *fb = plat->gbm_bo_get_user_data(bo);
+    uint32_t handles[4] = { 0 };
+    uint32_t pitches[4] = { 0 };
+    uint32_t offsets[4] = { 0 };
+    uint64_t modifiers[4] = { 0 };
+    uint64_t modifier = DRM_FORMAT_MOD_INVALID;
+    int num_planes = 1;
+    int ret;
+
+    if (fb) {
+        *fb_id = fb->fb_id;
+        return true;
+    }
+
+    fb = wcore_calloc(sizeof(*fb));
+    if (!fb)
+        return false;
+
+    if (plat->gbm_bo_get_modifier && plat->gbm_bo_get_plane_count &&
+        plat->gbm_bo_get_handle_for_plane &&
+        plat->gbm_bo_get_stride_for_plane && plat->gbm_bo_get_offset) {
+        modifier = plat->gbm_bo_get_modifier(bo);
+        num_planes = plat->gbm_bo_get_plane_count(bo);
+    }
+
+    if (modifier != DRM_FORMAT_MOD_INVALID && num_planes >= 1 &&
+        num_planes <= 4) {
+        // Tiled and compressed layouts need every plane and the modifier.
+        for (int i = 0; i < num_planes; ++i) {
+            handles[i] = plat->gbm_bo_get_handle_for_plane(bo, i).u32;
+            pitches[i] = plat->gbm_bo_get_stride_for_plane(bo, i);
+            offsets[i] = plat->gbm_bo_get_offset(bo, i);
+            modifiers[i] = modifier;
+        }
+
+        ret = drmModeAddFB2WithModifiers(self->fd,
+                                         plat->gbm_bo_get_width(bo),
+                                         plat->gbm_bo_get_height(bo),
+                                         wgbm_kms_get_fb_format(
+                                             plat->gbm_bo_get_format(bo)),
+                                         handles, pitches, offsets,
+                                         modifiers, &fb->fb_id,
+                                         DRM_MODE_FB_MODIFIERS);
+    } else {
+        handles[0] = plat->gbm_bo_get_handle(bo).u32;
+        pitches[0] = plat->gbm_bo_get_stride(bo);
+
+        ret = drmModeAddFB2(self->fd,
+                            plat->gbm_bo_get_width(bo),
+                            plat->gbm_bo_get_height(bo),
+                            wgbm_kms_get_fb_format(plat->gbm_bo_get_format(bo)),
+                            handles, pitches, offsets, &fb->fb_id, 0);
+    }
+
+    if (ret) {
+        wcore_error_errno("drmModeAddFB2 failed");
+        free(fb);
+        return false;
+    }
+
+    fb->fd = self->fd;
+    plat->gbm_bo_set_user_data(bo, fb, wgbm_kms_destroy_fb);
+
+    *fb_id = fb->fb_id;
+    return true;
+}
+
+static void
+wgbm_kms_page_flip_handler(int fd,
+                           unsigned int sequence,
+                           unsigned int tv_sec,
+                           unsigned int tv_usec,
+                           void *user_data)
+{
+    struct wgbm_kms *self = user_data;
+
+    self->flip_pending = false;
+}
+
+bool
+wgbm_kms_flip(struct wgbm_kms *self,
+              uint32_t fb_id,
+              uint32_t width,
+              uint32_t height)
+{
+    drmModeAtomicReqPtr req;
+    uint32_t flags = DRM_MODE_PAGE_FLIP_EVENT | DRM_MODE_ATOMIC_NONBLOCK;
+    int ret;
+
+    if (width > self->mode.hdisplay || height > self->mode.vdisplay) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "window %ux%u exceeds the KMS mode %ux%u",
+                     width, height, self->mode.hdisplay, self->mode.vdisplay);
+        return false;
+    }
+
+    req = drmModeAtomicAlloc();
+    if (!req) {
+        wcore_error(WAFFLE_ERROR_BAD_ALLOC);
+        return false;
+    }
+
+    if (self->needs_modeset) {
+        flags |= DRM_MODE_ATOMIC_ALLOW_MODESET;
+        drmModeAtomicAddProperty(req, self->connector_id,
+                                 self->connector_props.crtc_id,
+                                 self->crtc_id);
+        drmModeAtomicAddProperty(req, self->crtc_id,
+                                 self->crtc_props.mode_id,
+                                 self->mode_blob_id);
+        drmModeAtomicAddProperty(req, self->crtc_id,
+                                 self->crtc_props.active, 1);
+    }
+
+    // Plane source coordinates are 16.16 fixed point.
+    drmModeAtomicAddProperty(req, self->plane_id,
+                             self->plane_props.fb_id, fb_id);
+    drmModeAtomicAddProperty(req, self->plane_id,
+                             self->plane_props.crtc_id, self->crtc_id);
+    drmModeAtomicAddProperty(req, self->plane_id,
+                             self->plane_props.src_x, 0);
+    drmModeAtomicAddProperty(req, self->plane_id,
+                             self->plane_props.src_y, 0);
+    drmModeAtomicAddProperty(req, self->plane_id,
+                             self->plane_props.src_w, (uint64_t) width << 16);
+    drmModeAtomicAddProperty(req, self->plane_id,
+                             self->plane_props.src_h, (uint64_t) height << 16);
+    drmModeAtomicAddProperty(req, self->plane_id,
+                             self->plane_props.crtc_x, 0);
+    drmModeAtomicAddProperty(req, self->plane_id,
+                             self->plane_props.crtc_y, 0);
+    drmModeAtomicAddProperty(req, self->plane_id,
+                             self->plane_props.crtc_w, self->mode.hdisplay);
+    drmModeAtomicAddProperty(req, self->plane_id,
+                             self->plane_props.crtc_h, self->mode.vdisplay);
+
+    ret = drmModeAtomicCommit(self->fd, req, flags, self);
+    drmModeAtomicFree(req);
+
+    if (ret) {
+        wcore_error_errno("drmModeAtomicCommit failed");
+        return false;
+    }
+
+    self->needs_modeset = false;
+    self->flip_pending = true;
+    return true;
+}
+
+bool
+wgbm_kms_wait_flip(struct wgbm_kms *self)
+{
+    drmEventContext evctx = {
+        .version = 2,
+        .page_flip_handler = wgbm_kms_page_flip_handler,
+    };
+    struct pollfd pfd = {
+        .fd = self->fd,
+        .events = POLLIN,
+    };
+
+    while (self->flip_pending) {
+        int ret = poll(&pfd, 1, -1);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            wcore_error_errno("poll on the DRM fd failed");
+            return false;
+        }
+
+        if (drmHandleEvent(self->fd, &evctx)) {
+            wcore_error_errno("drmHandleEvent failed");
+            return false;
+        }
+    }
+
+    return true;
+}
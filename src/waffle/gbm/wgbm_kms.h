@@ -0,0 +1,121 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <xf86drmMode.h>
+
+struct gbm_bo;
+struct wgbm_platform;
+struct wgbm_window;
+
+/// @brief KMS output of a GBM display.
+///
+/// Drives one connector through atomic commits. Only one window at a time
+/// may scan out.
+struct wgbm_kms {
+    int fd;
+
+    uint32_t connector_id;
+    uint32_t crtc_id;
+    uint32_t plane_id;
+
+    drmModeModeInfo mode;
+    uint32_t mode_blob_id;
+
+    /// The first commit must enable the CRTC with the mode.
+    bool needs_modeset;
+
+    /// Set while a page flip is queued, and cleared by its event.
+    bool flip_pending;
+
+    struct wgbm_window *owner;
+
+    struct {
+        uint32_t crtc_id;
+    } connector_props;
+
+    struct {
+        uint32_t mode_id;
+        uint32_t active;
+    } crtc_props;
+
+    struct {
+        uint32_t fb_id;
+        uint32_t crtc_id;
+        uint32_t src_x;
+        uint32_t src_y;
+        uint32_t src_w;
+        uint32_t src_h;
+        uint32_t crtc_x;
+        uint32_t crtc_y;
+        uint32_t crtc_w;
+        uint32_t crtc_h;
+    } plane_props;
+};
+
+/// @brief Pick the first connected connector, a CRTC for it and the CRTC's
+/// primary plane.
+///
+/// The fd must be a primary node that supports atomic modesetting.
+struct wgbm_kms*
+wgbm_kms_create(int fd);
+
+/// Wait for any pending page flip and disable the CRTC.
+void
+wgbm_kms_destroy(struct wgbm_kms *self);
+
+/// @brief Turn off the CRTC and its plane, if a flip has enabled them.
+///
+/// This must precede removing the framebuffer on screen. The next flip
+/// enables the CRTC again.
+bool
+wgbm_kms_disable(struct wgbm_kms *self);
+
+/// @brief Get the framebuffer of a buffer, adding one on first use.
+///
+/// The framebuffer lives as long as the buffer.
+bool
+wgbm_kms_get_fb(struct wgbm_kms *self,
+                struct wgbm_platform *plat,
+                struct gbm_bo *bo,
+                uint32_t *fb_id);
+
+/// @brief Queue a page flip to @a fb_id without waiting for it.
+///
+/// The framebuffer is scaled to cover the whole screen, because most drivers
+/// reject a primary plane smaller than the mode.
+bool
+wgbm_kms_flip(struct wgbm_kms *self,
+              uint32_t fb_id,
+              uint32_t width,
+              uint32_t height);
+
+/// Block until the pending page flip, if any, has completed.
+bool
+wgbm_kms_wait_flip(struct wgbm_kms *self);
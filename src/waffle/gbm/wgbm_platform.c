@@ -34,10 +34,13 @@
 
 #include "wegl_config.h"
 #include "wegl_context.h"
+#include "wegl_fence.h"
+#include "wegl_image.h"
 #include "wegl_platform.h"
 #include "wegl_util.h"
 
 #include "wgbm_config.h"
+#include "wgbm_device.h"
 #include "wgbm_display.h"
 #include "wgbm_platform.h"
 #include "wgbm_window.h"
@@ -60,6 +63,8 @@ wgbm_platform_teardown(struct wgbm_platform *self)
     if (self->linux)
         ok &= linux_platform_destroy(self->linux);
 
+    wgbm_devices_destroy(self->devices);
+
     if (self->gbmHandle) {
         error = dlclose(self->gbmHandle);
         if (error) {
@@ -116,10 +121,20 @@ wgbm_platform_init(struct wgbm_platform *self)
     GBM_FUNCTIONS(RETRIEVE_GBM_SYMBOL);
 #undef RETRIEVE_GBM_SYMBOL
 
+#define RETRIEVE_OPTIONAL_GBM_SYMBOL(type, function, args)             \
+    self->function = dlsym(self->gbmHandle, #function);
+
+    GBM_OPTIONAL_FUNCTIONS(RETRIEVE_OPTIONAL_GBM_SYMBOL);
+#undef RETRIEVE_OPTIONAL_GBM_SYMBOL
+
     self->linux = linux_platform_create();
     if (!self->linux)
         goto error;
 
+    self->devices = wgbm_devices_create();
+    if (!self->devices)
+        goto error;
+
     setenv("EGL_PLATFORM", "drm", true);
 
     self->wegl.wcore.vtbl = &wgbm_platform_vtbl;
@@ -186,12 +201,14 @@ static const struct wcore_platform_vtbl wgbm_platform_vtbl = {
     .get_proc_address = wegl_get_proc_address,
     .dl_can_open = wgbm_dl_can_open,
     .dl_sym = wgbm_dl_sym,
+    .enumerate_devices = wgbm_enumerate_devices,
 
     .display = {
         .connect = wgbm_display_connect,
         .destroy = wgbm_display_destroy,
         .supports_context_api = wegl_display_supports_context_api,
         .get_native = wgbm_display_get_native,
+        .adopt_native = wgbm_display_adopt_native,
     },
 
     .config = {
@@ -202,8 +219,10 @@ static const struct wcore_platform_vtbl wgbm_platform_vtbl = {
 
     .context = {
         .create = wegl_context_create,
+        .create_no_config = wegl_context_create_no_config,
         .destroy = wegl_context_destroy,
         .get_native = wgbm_context_get_native,
+        .get_attrib = wegl_context_get_attrib,
     },
 
     .window = {
@@ -211,6 +230,29 @@ static const struct wcore_platform_vtbl wgbm_platform_vtbl = {
         .destroy = wgbm_window_destroy,
         .show = wgbm_window_show,
         .swap_buffers = wgbm_window_swap_buffers,
+        .resize = wgbm_window_resize,
         .get_native = wgbm_window_get_native,
+        .get_attrib = wgbm_window_get_attrib,
+        .export_frame = wgbm_window_export_frame,
+        .release_frame = wgbm_window_release_frame,
+        .map_front_buffer = wgbm_window_map_front_buffer,
+        .unmap_front_buffer = wgbm_window_unmap_front_buffer,
+        .adopt_native = wgbm_window_adopt_native,
+    },
+
+    .image = {
+        .create_from_dmabuf = wegl_image_create_from_dmabuf,
+        .create_from_texture = wegl_image_create_from_texture,
+        .destroy = wegl_image_destroy,
+        .bind_texture = wegl_image_bind_texture,
+        .export_dmabuf = wegl_image_export_dmabuf,
+    },
+
+    .fence = {
+        .create = wegl_fence_create,
+        .destroy = wegl_fence_destroy,
+        .wait = wegl_fence_wait,
+        .server_wait = wegl_fence_server_wait,
+        .export_fd = wegl_fence_export_fd,
     },
 };
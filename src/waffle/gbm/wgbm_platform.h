@@ -41,19 +41,44 @@
     f(struct gbm_surface *, gbm_surface_create           , (struct gbm_device *gbm, uint32_t width, uint32_t height, uint32_t format, uint32_t flags)) \
     f(void                , gbm_surface_destroy          , (struct gbm_surface *surface)) \
     f(struct gbm_bo *     , gbm_surface_lock_front_buffer, (struct gbm_surface *surface)) \
-    f(void                , gbm_surface_release_buffer   , (struct gbm_surface *surface, struct gbm_bo *bo))
+    f(void                , gbm_surface_release_buffer   , (struct gbm_surface *surface, struct gbm_bo *bo)) \
+    f(uint32_t            , gbm_bo_get_width             , (struct gbm_bo *bo)) \
+    f(uint32_t            , gbm_bo_get_height            , (struct gbm_bo *bo)) \
+    f(uint32_t            , gbm_bo_get_stride            , (struct gbm_bo *bo)) \
+    f(uint32_t            , gbm_bo_get_format            , (struct gbm_bo *bo)) \
+    f(union gbm_bo_handle , gbm_bo_get_handle            , (struct gbm_bo *bo)) \
+    f(void                , gbm_bo_set_user_data         , (struct gbm_bo *bo, void *data, void (*destroy_user_data)(struct gbm_bo *, void *))) \
+    f(void *              , gbm_bo_get_user_data         , (struct gbm_bo *bo)) \
+    f(int                 , gbm_bo_get_fd                , (struct gbm_bo *bo))
+
+/// Functions missing from older libgbm. Their pointers may be null.
+#define GBM_OPTIONAL_FUNCTIONS(f) \
+    f(int                 , gbm_bo_get_plane_count       , (struct gbm_bo *bo)) \
+    f(uint32_t            , gbm_bo_get_stride_for_plane  , (struct gbm_bo *bo, int plane)) \
+    f(uint32_t            , gbm_bo_get_offset            , (struct gbm_bo *bo, int plane)) \
+    f(uint64_t            , gbm_bo_get_modifier          , (struct gbm_bo *bo)) \
+    f(union gbm_bo_handle , gbm_bo_get_handle_for_plane  , (struct gbm_bo *bo, int plane)) \
+    f(struct gbm_surface *, gbm_surface_create_with_modifiers, (struct gbm_device *gbm, uint32_t width, uint32_t height, uint32_t format, const uint64_t *modifiers, const unsigned int count)) \
+    f(struct gbm_surface *, gbm_surface_create_with_modifiers2, (struct gbm_device *gbm, uint32_t width, uint32_t height, uint32_t format, const uint64_t *modifiers, const unsigned int count, uint32_t flags)) \
+    f(void *              , gbm_bo_map                   , (struct gbm_bo *bo, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t flags, uint32_t *stride, void **map_data)) \
+    f(void                , gbm_bo_unmap                 , (struct gbm_bo *bo, void *map_data))
 
 struct linux_platform;
+struct wgbm_devices;
 
 struct wgbm_platform {
     struct wegl_platform wegl;
     struct linux_platform *linux;
 
+    /// The drm device nodes, scanned once and refreshed on hotplug.
+    struct wgbm_devices *devices;
+
     // GBM function pointers
     void *gbmHandle;
 
 #define DECLARE(type, function, args) type (*function) args;
     GBM_FUNCTIONS(DECLARE)
+    GBM_OPTIONAL_FUNCTIONS(DECLARE)
 #undef DECLARE
 };
 
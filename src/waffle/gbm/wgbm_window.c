@@ -23,9 +23,15 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#define _POSIX_C_SOURCE 200809L // F_DUPFD_CLOEXEC
+
+#include <fcntl.h>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
+#include <drm_fourcc.h>
 #include <gbm.h>
 
 #include "waffle_gbm.h"
@@ -34,29 +40,353 @@
 #include "wcore_error.h"
 
 #include "wegl_config.h"
+#include "wegl_display.h"
+#include "wegl_util.h"
 
 #include "wgbm_config.h"
 #include "wgbm_display.h"
+#include "wgbm_kms.h"
 #include "wgbm_platform.h"
 #include "wgbm_window.h"
 
+// GBM_BO_USE_PROTECTED is an enumerator, which older gbm.h lacks.
+#define WGBM_BO_USE_PROTECTED (1 << 5)
+
+static int32_t
+wgbm_window_newest_slot(struct wgbm_window *self)
+{
+    assert(self->locked.count > 0);
+    return (self->locked.head + self->locked.count - 1) %
+           WGBM_WINDOW_MAX_BUFFERS;
+}
+
+static struct gbm_bo*
+wgbm_window_newest(struct wgbm_window *self)
+{
+    if (self->locked.count == 0)
+        return NULL;
+
+    return self->locked.slots[wgbm_window_newest_slot(self)].bo;
+}
+
+static void
+wgbm_window_push(struct wgbm_window *self,
+                 struct gbm_surface *surface,
+                 struct gbm_bo *bo)
+{
+    int32_t i;
+
+    assert(self->locked.count < WGBM_WINDOW_MAX_BUFFERS);
+
+    i = (self->locked.head + self->locked.count) % WGBM_WINDOW_MAX_BUFFERS;
+    self->locked.slots[i].surface = surface;
+    self->locked.slots[i].bo = bo;
+    self->locked.slots[i].holds = 0;
+    self->locked.count++;
+}
+
+static void
+wgbm_window_release_oldest(struct wgbm_window *self,
+                           struct wgbm_platform *plat)
+{
+    int32_t i = self->locked.head;
+
+    plat->gbm_surface_release_buffer(self->locked.slots[i].surface,
+                                     self->locked.slots[i].bo);
+
+    self->locked.slots[i].surface = NULL;
+    self->locked.slots[i].bo = NULL;
+    self->locked.slots[i].holds = 0;
+    self->locked.head = (i + 1) % WGBM_WINDOW_MAX_BUFFERS;
+    self->locked.count--;
+}
+
+/// Release the locked buffer @a n places after the oldest, keeping the others
+/// in order.
+static void
+wgbm_window_release_at(struct wgbm_window *self,
+                       struct wgbm_platform *plat,
+                       int32_t n)
+{
+    int32_t i = (self->locked.head + n) % WGBM_WINDOW_MAX_BUFFERS;
+
+    plat->gbm_surface_release_buffer(self->locked.slots[i].surface,
+                                     self->locked.slots[i].bo);
+
+    for (; n < self->locked.count - 1; ++n) {
+        int32_t next = (i + 1) % WGBM_WINDOW_MAX_BUFFERS;
+
+        self->locked.slots[i] = self->locked.slots[next];
+        i = next;
+    }
+
+    self->locked.slots[i].surface = NULL;
+    self->locked.slots[i].bo = NULL;
+    self->locked.slots[i].holds = 0;
+    self->locked.count--;
+}
+
+/// @brief Release the buffers beyond buffer_count - 1 that no exported frame
+/// holds, oldest first.
+///
+/// The newest buffer is never released. One buffer stays free for rendering
+/// unless held buffers use it.
+static bool
+wgbm_window_release_unheld(struct wgbm_window *self,
+                           struct wgbm_platform *plat)
+{
+    int32_t n = 0;
+
+    while (self->locked.count > self->buffer_count - 1 &&
+           n < self->locked.count - 1) {
+        int32_t i = (self->locked.head + n) % WGBM_WINDOW_MAX_BUFFERS;
+
+        if (self->locked.slots[i].holds > 0) {
+            ++n;
+            continue;
+        }
+
+        // With KMS, the last queued flip completes before the buffer on
+        // screen may be released. Older buffers are already off screen.
+        if (self->kms && n == self->locked.count - 2 &&
+            !wgbm_kms_wait_flip(self->kms))
+            return false;
+
+        wgbm_window_release_at(self, plat, n);
+    }
+
+    return true;
+}
+
+static void
+wgbm_window_unmap(struct wgbm_window *self,
+                  struct wgbm_platform *plat)
+{
+    if (!self->mapped_bo)
+        return;
+
+    plat->gbm_bo_unmap(self->mapped_bo, self->map_data);
+    self->mapped_bo = NULL;
+    self->map_data = NULL;
+    self->map_ptr = NULL;
+}
+
+/// Release the locked buffers of @a surface, keeping the others in order.
+static void
+wgbm_window_release_surface(struct wgbm_window *self,
+                            struct wgbm_platform *plat,
+                            struct gbm_surface *surface)
+{
+    int32_t count = self->locked.count;
+
+    self->locked.count = 0;
+
+    for (int32_t n = 0; n < count; ++n) {
+        int32_t i = (self->locked.head + n) % WGBM_WINDOW_MAX_BUFFERS;
+        struct gbm_surface *bo_surface = self->locked.slots[i].surface;
+        struct gbm_bo *bo = self->locked.slots[i].bo;
+        int32_t holds = self->locked.slots[i].holds;
+
+        self->locked.slots[i].surface = NULL;
+        self->locked.slots[i].bo = NULL;
+        self->locked.slots[i].holds = 0;
+
+        if (bo_surface == surface) {
+            plat->gbm_surface_release_buffer(surface, bo);
+        }
+        else {
+            wgbm_window_push(self, bo_surface, bo);
+            self->locked.slots[wgbm_window_newest_slot(self)].holds = holds;
+        }
+    }
+}
+
+/// True if a buffer of @a surface is held by an export.
+static bool
+wgbm_window_surface_held(struct wgbm_window *self,
+                         struct gbm_surface *surface)
+{
+    for (int32_t n = 0; n < self->locked.count; ++n) {
+        int32_t i = (self->locked.head + n) % WGBM_WINDOW_MAX_BUFFERS;
+
+        if (self->locked.slots[i].surface == surface &&
+            self->locked.slots[i].holds > 0)
+            return true;
+    }
+
+    return false;
+}
+
+static bool
+wgbm_window_destroy_surface(struct wgbm_window *self,
+                            struct wgbm_platform *plat,
+                            struct wgbm_window_surface *surface)
+{
+    struct wegl_display *dpy = wegl_display(self->wegl.wcore.display);
+    bool ok = true;
+
+    wgbm_window_release_surface(self, plat, surface->gbm);
+
+    if (surface->egl && !plat->wegl.eglDestroySurface(dpy->egl,
+                                                      surface->egl)) {
+        wegl_emit_error(&plat->wegl, "eglDestroySurface");
+        ok = false;
+    }
+
+    plat->gbm_surface_destroy(surface->gbm);
+    return ok;
+}
+
 bool
 wgbm_window_destroy(struct wcore_window *wc_self)
 {
-    struct wcore_platform *wc_plat = wc_self->display->platform;
-    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
     struct wgbm_window *self = wgbm_window(wc_self);
+    struct wgbm_platform *plat;
     bool ok = true;
 
     if (!self)
         return ok;
 
+    plat = wgbm_platform(wegl_platform(wc_self->display->platform));
+
+    // Destroying the surfaces removes the framebuffer on screen.
+    if (self->kms) {
+        ok &= wgbm_kms_disable(self->kms);
+        self->kms->owner = NULL;
+    }
+
+    wgbm_window_unmap(self, plat);
+
+    while (self->locked.count > 0)
+        wgbm_window_release_oldest(self, plat);
+
+    for (int32_t i = 0; i < self->pool_count; ++i)
+        ok &= wgbm_window_destroy_surface(self, plat, &self->pool[i]);
+
     ok &= wegl_window_teardown(&self->wegl);
-    plat->gbm_surface_destroy(self->gbm_surface);
+    if (self->gbm_surface && !self->adopted)
+        plat->gbm_surface_destroy(self->gbm_surface);
+    free(self->modifiers);
     free(self);
     return ok;
 }
 
+/// @brief Parse WAFFLE_WINDOW_GBM_MODIFIERS, WAFFLE_WINDOW_GBM_USAGE and
+/// WAFFLE_WINDOW_BUFFER_COUNT.
+///
+/// On success, @a modifiers points into the caller's list, and is null if the
+/// list leaves the layout to the driver. @a buffer_count is 0 if unset.
+static bool
+wgbm_window_parse_attrib_list(struct wgbm_platform *plat,
+                              const intptr_t attrib_list[],
+                              const uint64_t **modifiers,
+                              unsigned *num_modifiers,
+                              uint32_t *gbm_flags,
+                              int32_t *buffer_count)
+{
+    intptr_t *attribs;
+    intptr_t modifiers_handle = 0;
+    intptr_t usage = 0;
+    intptr_t count = 0;
+    bool ok = false;
+
+    attribs = wcore_attrib_list_copy(attrib_list);
+    if (!attribs)
+        return false;
+
+    wcore_attrib_list_pop(attribs, WAFFLE_WINDOW_GBM_MODIFIERS,
+                          &modifiers_handle);
+    wcore_attrib_list_pop(attribs, WAFFLE_WINDOW_GBM_USAGE, &usage);
+    wcore_attrib_list_pop(attribs, WAFFLE_WINDOW_BUFFER_COUNT, &count);
+
+    if (wcore_attrib_list_length(attribs) > 0) {
+        wcore_error_bad_attribute(attribs[0]);
+        goto done;
+    }
+
+    // wcore_window_attrs_parse() has checked the minimum.
+    if (count > WGBM_WINDOW_MAX_BUFFERS) {
+        wcore_errorf(WAFFLE_ERROR_BAD_ATTRIBUTE,
+                     "WAFFLE_WINDOW_BUFFER_COUNT must be from 2 to %d",
+                     WGBM_WINDOW_MAX_BUFFERS);
+        goto done;
+    }
+
+    *buffer_count = (int32_t) count;
+
+    // wcore_window_attrs_parse() has checked the usage bits and modifiers.
+    *gbm_flags = GBM_BO_USE_RENDERING;
+    if (usage & WAFFLE_GBM_USAGE_SCANOUT)
+        *gbm_flags |= GBM_BO_USE_SCANOUT;
+    if (usage & WAFFLE_GBM_USAGE_LINEAR)
+        *gbm_flags |= GBM_BO_USE_LINEAR;
+    if (usage & WAFFLE_GBM_USAGE_PROTECTED)
+        *gbm_flags |= WGBM_BO_USE_PROTECTED;
+
+    *modifiers = (const uint64_t *) modifiers_handle;
+    *num_modifiers = 0;
+
+    if (!*modifiers) {
+        ok = true;
+        goto done;
+    }
+
+    while ((*modifiers)[*num_modifiers] != DRM_FORMAT_MOD_INVALID)
+        ++*num_modifiers;
+
+    // gbm_surface_create_with_modifiers() predates usage flags and implies
+    // rendering and scanout.
+    if (!plat->gbm_surface_create_with_modifiers2 &&
+        (!plat->gbm_surface_create_with_modifiers ||
+         (usage & WAFFLE_GBM_USAGE_PROTECTED))) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "libgbm cannot create a surface with these modifiers "
+                     "and usage flags");
+        goto done;
+    }
+
+    ok = true;
+
+done:
+    free(attribs);
+    return ok;
+}
+
+static struct gbm_surface*
+wgbm_window_create_gbm_surface(struct wgbm_window *self,
+                               struct wgbm_platform *plat,
+                               int32_t width,
+                               int32_t height)
+{
+    struct wgbm_display *dpy = wgbm_display(self->wegl.wcore.display);
+    struct gbm_surface *surface;
+
+    if (self->modifiers && plat->gbm_surface_create_with_modifiers2) {
+        surface = plat->gbm_surface_create_with_modifiers2(dpy->gbm_device,
+                                                           width, height,
+                                                           self->gbm_format,
+                                                           self->modifiers,
+                                                           self->num_modifiers,
+                                                           self->gbm_flags);
+    } else if (self->modifiers) {
+        surface = plat->gbm_surface_create_with_modifiers(dpy->gbm_device,
+                                                          width, height,
+                                                          self->gbm_format,
+                                                          self->modifiers,
+                                                          self->num_modifiers);
+    } else {
+        surface = plat->gbm_surface_create(dpy->gbm_device,
+                                           width, height,
+                                           self->gbm_format,
+                                           self->gbm_flags);
+    }
+
+    if (!surface)
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "gbm_surface_create failed");
+
+    return surface;
+}
+
 struct wcore_window*
 wgbm_window_create(struct wcore_platform *wc_plat,
                    struct wcore_config *wc_config,
@@ -67,36 +397,113 @@ wgbm_window_create(struct wcore_platform *wc_plat,
     struct wgbm_display *dpy = wgbm_display(wc_config->display);
     struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
     struct wgbm_window *self;
-    uint32_t gbm_format;
+    const uint64_t *modifiers;
+    unsigned num_modifiers;
+    int32_t buffer_count;
+    uint32_t gbm_flags;
     bool ok = true;
 
     if (width == -1 && height == -1) {
+        if (!dpy->kms) {
+            wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                         "fullscreen window requires WAFFLE_GBM_KMS");
+            return NULL;
+        }
+
+        width = dpy->kms->mode.hdisplay;
+        height = dpy->kms->mode.vdisplay;
+    }
+
+    if (dpy->kms && dpy->kms->owner) {
         wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
-                     "fullscreen window not supported");
+                     "another window already scans out to the KMS output");
         return NULL;
     }
 
-    if (wcore_attrib_list_length(attrib_list) > 0) {
-        wcore_error_bad_attribute(attrib_list[0]);
+    if (!wgbm_window_parse_attrib_list(plat, attrib_list, &modifiers,
+                                       &num_modifiers, &gbm_flags,
+                                       &buffer_count))
         return NULL;
-    }
 
     self = wcore_calloc(sizeof(*self));
     if (self == NULL)
         return NULL;
 
-    gbm_format = wgbm_config_get_gbm_format(wc_plat, wc_config->display,
-                                            wc_config);
-    assert(gbm_format != 0);
-    self->gbm_surface = plat->gbm_surface_create(dpy->gbm_device,
-                                                 width, height, gbm_format,
-                                                 GBM_BO_USE_RENDERING);
-    if (!self->gbm_surface) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "gbm_surface_create failed");
+    // wgbm_window_destroy() and wgbm_window_create_gbm_surface() need the
+    // display.
+    self->wegl.wcore.display = wc_config->display;
+
+    // By default, keep the previous behaviour: one buffer on screen and one
+    // queued for KMS, or the last presented buffer otherwise.
+    if (buffer_count == 0)
+        buffer_count = dpy->kms ? 3 : 2;
+    self->buffer_count = buffer_count;
+
+    if (dpy->kms) {
+        self->kms = dpy->kms;
+        dpy->kms->owner = self;
+        gbm_flags |= GBM_BO_USE_SCANOUT;
+    }
+
+    self->gbm_format = wgbm_config_get_gbm_format(wc_plat, wc_config->display,
+                                                  wc_config);
+    assert(self->gbm_format != 0);
+    self->gbm_flags = gbm_flags;
+
+    // Resizing creates surfaces after the caller's list is gone.
+    if (modifiers) {
+        self->modifiers = wcore_calloc(num_modifiers * sizeof(*modifiers));
+        if (!self->modifiers)
+            goto error;
+
+        memcpy(self->modifiers, modifiers,
+               num_modifiers * sizeof(*modifiers));
+        self->num_modifiers = num_modifiers;
+    }
+
+    self->gbm_surface = wgbm_window_create_gbm_surface(self, plat,
+                                                       width, height);
+    if (!self->gbm_surface)
+        goto error;
+
+    self->width = width;
+    self->height = height;
+
+    ok = wegl_window_init(&self->wegl, wc_config,
+                          (intptr_t) self->gbm_surface);
+    if (!ok)
         goto error;
+
+    return &self->wegl.wcore;
+
+error:
+    wgbm_window_destroy(&self->wegl.wcore);
+    return NULL;
+}
+
+struct wcore_window*
+wgbm_window_adopt_native(struct wcore_platform *wc_plat,
+                         struct wcore_config *wc_config,
+                         union waffle_native_window *native)
+{
+    struct wgbm_window *self;
+    bool ok = true;
+
+    if (!native->gbm || !native->gbm->gbm_surface) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "native->gbm->gbm_surface is null");
+        return NULL;
     }
 
+    self = wcore_calloc(sizeof(*self));
+    if (self == NULL)
+        return NULL;
+
+    // wgbm_window_destroy() needs the display.
+    self->wegl.wcore.display = wc_config->display;
+    self->gbm_surface = native->gbm->gbm_surface;
+    self->adopted = true;
+
     ok = wegl_window_init(&self->wegl, wc_config,
                           (intptr_t) self->gbm_surface);
     if (!ok)
@@ -117,6 +524,30 @@ wgbm_window_show(struct wcore_window *wc_self)
 }
 
 
+/// @brief Queue @a bo for scanout.
+///
+/// At most one flip is in flight. Waiting for the previous one here, rather
+/// than after queueing, lets rendering of the next frame overlap it.
+static bool
+wgbm_window_flip(struct wgbm_window *self,
+                 struct wgbm_platform *plat,
+                 struct gbm_bo *bo)
+{
+    struct wgbm_kms *kms = self->kms;
+    uint32_t fb_id;
+
+    if (!wgbm_kms_get_fb(kms, plat, bo, &fb_id))
+        return false;
+
+    if (!wgbm_kms_wait_flip(kms))
+        return false;
+
+    return wgbm_kms_flip(kms, fb_id,
+                         plat->gbm_bo_get_width(bo),
+                         plat->gbm_bo_get_height(bo));
+}
+
+
 bool
 wgbm_window_swap_buffers(struct wcore_window *wc_self)
 {
@@ -127,11 +558,137 @@ wgbm_window_swap_buffers(struct wcore_window *wc_self)
         return false;
 
     struct wgbm_window *self = wgbm_window(wc_self);
+    if (self->adopted)
+        return true;
+
+    wgbm_window_unmap(self, plat);
+
     struct gbm_bo *bo = plat->gbm_surface_lock_front_buffer(self->gbm_surface);
     if (!bo)
         return false;
 
-    plat->gbm_surface_release_buffer(self->gbm_surface, bo);
+    if (self->kms && !wgbm_window_flip(self, plat, bo)) {
+        plat->gbm_surface_release_buffer(self->gbm_surface, bo);
+        return false;
+    }
+
+    wgbm_window_push(self, self->gbm_surface, bo);
+
+    if (!wgbm_window_release_unheld(self, plat))
+        return false;
+
+    if (self->locked.count == WGBM_WINDOW_MAX_BUFFERS) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "exported frames hold every buffer of the window; "
+                     "release one with waffle_window_release_frame() "
+                     "before rendering again");
+        return false;
+    }
+
+    return true;
+}
+
+
+bool
+wgbm_window_resize(struct wcore_window *wc_self,
+                   int32_t width, int32_t height)
+{
+    struct wcore_platform *wc_plat = wc_self->display->platform;
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+    struct wegl_display *dpy = wegl_display(wc_self->display);
+    struct wgbm_window *self = wgbm_window(wc_self);
+    struct wgbm_window_surface next = { 0 };
+    struct gbm_surface *on_screen = NULL;
+    EGLContext ctx;
+    int32_t i;
+
+    if (self->adopted) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "the application owns the size of an adopted "
+                     "gbm_surface");
+        return false;
+    }
+
+    if (width == self->width && height == self->height)
+        return true;
+
+    // Resizing may release the mapped buffer.
+    wgbm_window_unmap(self, plat);
+
+    // Once the last flip completes, the newest buffer is on screen, and its
+    // surface must outlive it.
+    if (self->kms) {
+        if (!wgbm_kms_wait_flip(self->kms))
+            return false;
+
+        if (self->locked.count > 0) {
+            i = wgbm_window_newest_slot(self);
+            on_screen = self->locked.slots[i].surface;
+        }
+    }
+
+    for (i = 0; i < self->pool_count; ++i) {
+        if (self->pool[i].width == width && self->pool[i].height == height)
+            break;
+    }
+
+    if (i < self->pool_count) {
+        next = self->pool[i];
+        memmove(&self->pool[i], &self->pool[i + 1],
+                (self->pool_count - i - 1) * sizeof(self->pool[0]));
+        self->pool_count--;
+    } else {
+        next.width = width;
+        next.height = height;
+        next.gbm = wgbm_window_create_gbm_surface(self, plat, width, height);
+        if (!next.gbm)
+            return false;
+
+        next.egl = wegl_window_create_surface(&self->wegl,
+                                              (intptr_t) next.gbm);
+        if (!next.egl) {
+            plat->gbm_surface_destroy(next.gbm);
+            return false;
+        }
+    }
+
+    // If the window is current to this thread, then keep it current.
+    ctx = plat->wegl.eglGetCurrentContext();
+    if (ctx != EGL_NO_CONTEXT &&
+        plat->wegl.eglGetCurrentSurface(EGL_DRAW) == self->wegl.egl &&
+        !plat->wegl.eglMakeCurrent(dpy->egl, next.egl, next.egl, ctx)) {
+        wegl_emit_error(&plat->wegl, "eglMakeCurrent");
+        wgbm_window_destroy_surface(self, plat, &next);
+        return false;
+    }
+
+    // Evict the least recently used surfaces whose buffers are neither on
+    // screen nor held by an export. Releasing a held buffer would let the
+    // surface reuse it under the consumer.
+    for (i = self->pool_count - 1;
+         i >= 0 && self->pool_count >= WGBM_WINDOW_POOL_SIZE; --i) {
+        if (self->pool[i].gbm == on_screen ||
+            wgbm_window_surface_held(self, self->pool[i].gbm))
+            continue;
+
+        wgbm_window_destroy_surface(self, plat, &self->pool[i]);
+        memmove(&self->pool[i], &self->pool[i + 1],
+                (self->pool_count - i - 1) * sizeof(self->pool[0]));
+        self->pool_count--;
+    }
+
+    memmove(&self->pool[1], &self->pool[0],
+            self->pool_count * sizeof(self->pool[0]));
+    self->pool[0].width = self->width;
+    self->pool[0].height = self->height;
+    self->pool[0].gbm = self->gbm_surface;
+    self->pool[0].egl = self->wegl.egl;
+    self->pool_count++;
+
+    self->width = next.width;
+    self->height = next.height;
+    self->gbm_surface = next.gbm;
+    self->wegl.egl = next.egl;
     return true;
 }
 
@@ -153,3 +710,216 @@ wgbm_window_get_native(struct wcore_window *wc_self)
 
     return n_window;
 }
+
+bool
+wgbm_window_get_attrib(struct wcore_window *wc_self,
+                       int32_t attrib,
+                       intptr_t *value)
+{
+    struct wcore_platform *wc_plat = wc_self->display->platform;
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+    struct wgbm_window *self = wgbm_window(wc_self);
+    struct gbm_bo *bo;
+    uint64_t modifier = DRM_FORMAT_MOD_INVALID;
+
+    switch (attrib) {
+        case WAFFLE_WINDOW_GBM_MODIFIER:
+            break;
+        default:
+            wcore_error_bad_attribute(attrib);
+            return false;
+    }
+
+    if (self->adopted) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "the application owns the buffers of an adopted "
+                     "gbm_surface");
+        return false;
+    }
+
+    // GBM picks the layout when it allocates the first buffer.
+    bo = wgbm_window_newest(self);
+    if (!bo) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "the window has not presented a frame");
+        return false;
+    }
+
+    if (plat->gbm_bo_get_modifier)
+        modifier = plat->gbm_bo_get_modifier(bo);
+
+    if (modifier > (uint64_t) INTPTR_MAX) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "modifier %#" PRIx64 " does not fit in intptr_t; "
+                     "use waffle_window_export_frame", modifier);
+        return false;
+    }
+
+    *value = (intptr_t) modifier;
+    return true;
+}
+
+bool
+wgbm_window_export_frame(struct wcore_window *wc_self,
+                         struct waffle_dmabuf *frame)
+{
+    struct wcore_platform *wc_plat = wc_self->display->platform;
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+    struct wgbm_window *self = wgbm_window(wc_self);
+    struct gbm_bo *bo;
+    int32_t num_planes = 1;
+
+    if (self->adopted) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "the application owns the buffers of an adopted "
+                     "gbm_surface");
+        return false;
+    }
+
+    bo = wgbm_window_newest(self);
+    if (!bo) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "the window has not presented a frame");
+        return false;
+    }
+
+    if (plat->gbm_bo_get_plane_count)
+        num_planes = plat->gbm_bo_get_plane_count(bo);
+
+    if (num_planes < 1 || num_planes > WAFFLE_DMABUF_MAX_PLANES) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "gbm_bo has %d planes", num_planes);
+        return false;
+    }
+
+    memset(frame, 0, sizeof(*frame));
+    frame->width = plat->gbm_bo_get_width(bo);
+    frame->height = plat->gbm_bo_get_height(bo);
+    frame->fourcc = plat->gbm_bo_get_format(bo);
+    frame->modifier = plat->gbm_bo_get_modifier ?
+                      plat->gbm_bo_get_modifier(bo) :
+                      DRM_FORMAT_MOD_INVALID;
+    frame->num_planes = num_planes;
+
+    for (int32_t i = 0; i < WAFFLE_DMABUF_MAX_PLANES; ++i)
+        frame->fds[i] = -1;
+
+    // The planes of a surface buffer share one buffer object, so each plane
+    // gets its own descriptor of the same dma-buf.
+    for (int32_t i = 0; i < num_planes; ++i) {
+        frame->fds[i] = i == 0 ? plat->gbm_bo_get_fd(bo)
+                               : fcntl(frame->fds[0], F_DUPFD_CLOEXEC, 0);
+        if (frame->fds[i] < 0) {
+            wcore_error_errno("failed to export gbm_bo plane %d", i);
+            goto error;
+        }
+
+        if (plat->gbm_bo_get_stride_for_plane) {
+            frame->strides[i] = plat->gbm_bo_get_stride_for_plane(bo, i);
+            frame->offsets[i] = plat->gbm_bo_get_offset(bo, i);
+        }
+        else {
+            frame->strides[i] = plat->gbm_bo_get_stride(bo);
+        }
+    }
+
+    self->locked.slots[wgbm_window_newest_slot(self)].holds++;
+    return true;
+
+error:
+    for (int32_t i = 0; i < num_planes; ++i) {
+        if (frame->fds[i] >= 0)
+            close(frame->fds[i]);
+        frame->fds[i] = -1;
+    }
+    return false;
+}
+
+bool
+wgbm_window_release_frame(struct wcore_window *wc_self)
+{
+    struct wcore_platform *wc_plat = wc_self->display->platform;
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+    struct wgbm_window *self = wgbm_window(wc_self);
+
+    for (int32_t n = 0; n < self->locked.count; ++n) {
+        int32_t i = (self->locked.head + n) % WGBM_WINDOW_MAX_BUFFERS;
+
+        if (self->locked.slots[i].holds > 0) {
+            self->locked.slots[i].holds--;
+            return wgbm_window_release_unheld(self, plat);
+        }
+    }
+
+    wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                 "the window holds no exported frame");
+    return false;
+}
+
+bool
+wgbm_window_map_front_buffer(struct wcore_window *wc_self,
+                             struct waffle_mapped_frame *frame)
+{
+    struct wcore_platform *wc_plat = wc_self->display->platform;
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+    struct wgbm_window *self = wgbm_window(wc_self);
+    struct gbm_bo *bo;
+    uint32_t width, height;
+
+    if (self->adopted) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "the application owns the buffers of an adopted "
+                     "gbm_surface");
+        return false;
+    }
+
+    if (!plat->gbm_bo_map || !plat->gbm_bo_unmap) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "libgbm lacks gbm_bo_map");
+        return false;
+    }
+
+    bo = wgbm_window_newest(self);
+    if (!bo) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "the window has not presented a frame");
+        return false;
+    }
+
+    width = plat->gbm_bo_get_width(bo);
+    height = plat->gbm_bo_get_height(bo);
+
+    // The buffer stays locked until the next swap, which unmaps it first, so
+    // mapping it needs no copy into a buffer of our own.
+    if (bo != self->mapped_bo) {
+        wgbm_window_unmap(self, plat);
+
+        self->map_ptr = plat->gbm_bo_map(bo, 0, 0, width, height,
+                                         GBM_BO_TRANSFER_READ,
+                                         &self->map_stride,
+                                         &self->map_data);
+        if (!self->map_ptr) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN, "gbm_bo_map failed");
+            return false;
+        }
+
+        self->mapped_bo = bo;
+    }
+
+    frame->data = self->map_ptr;
+    frame->width = width;
+    frame->height = height;
+    frame->stride = self->map_stride;
+    frame->fourcc = plat->gbm_bo_get_format(bo);
+    return true;
+}
+
+bool
+wgbm_window_unmap_front_buffer(struct wcore_window *wc_self)
+{
+    struct wcore_platform *wc_plat = wc_self->display->platform;
+    struct wgbm_platform *plat = wgbm_platform(wegl_platform(wc_plat));
+
+    wgbm_window_unmap(wgbm_window(wc_self), plat);
+    return true;
+}
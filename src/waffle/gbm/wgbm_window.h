@@ -26,15 +26,92 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "wegl_window.h"
 
 struct wcore_platform;
 struct gbm_surface;
+struct wgbm_kms;
+
+/// Mesa's gbm_surface allocates at most four buffers.
+#define WGBM_WINDOW_MAX_BUFFERS 4
+
+/// Number of inactive sizes whose surfaces a window keeps.
+#define WGBM_WINDOW_POOL_SIZE 2
+
+/// A gbm_surface and the EGLSurface that renders to it.
+struct wgbm_window_surface {
+    int32_t width;
+    int32_t height;
+    struct gbm_surface *gbm;
+    EGLSurface egl;
+};
 
 struct wgbm_window {
     struct gbm_surface *gbm_surface;
     struct wegl_window wegl;
+
+    /// Size of gbm_surface.
+    int32_t width;
+    int32_t height;
+
+    // For creating surfaces of other sizes.
+    uint32_t gbm_format;
+    uint32_t gbm_flags;
+    uint64_t *modifiers;
+    unsigned num_modifiers;
+
+    /// @brief Surfaces of recent sizes other than the current one, most
+    /// recent first.
+    ///
+    /// Resizing back to one of these sizes reuses its surfaces instead of
+    /// allocating new ones. A surface whose buffer is on screen or held by an
+    /// export stays beyond WGBM_WINDOW_POOL_SIZE until it is released. Each
+    /// such surface has a locked buffer, which bounds their number.
+    struct wgbm_window_surface pool[WGBM_WINDOW_POOL_SIZE +
+                                    WGBM_WINDOW_MAX_BUFFERS];
+    int32_t pool_count;
+
+    /// The gbm_surface belongs to the application, which also locks and
+    /// releases its front buffers.
+    bool adopted;
+
+    /// Null unless the window scans out to the display's KMS output.
+    struct wgbm_kms *kms;
+
+    /// @brief Buffers in flight, including the one being rendered.
+    ///
+    /// From WAFFLE_WINDOW_BUFFER_COUNT.
+    int32_t buffer_count;
+
+    /// @brief Presented buffers that are still locked, oldest first.
+    ///
+    /// Once buffer_count - 1 newer buffers are locked, a buffer returns to the
+    /// surface, unless an exported frame still holds it. Held buffers stay
+    /// locked until waffle_window_release_frame(), and may exceed
+    /// buffer_count. With KMS, the newest buffer is queued for scanout, and
+    /// the one before it is on screen.
+    struct {
+        struct {
+            /// The surface of bo, which a resize may have replaced.
+            struct gbm_surface *surface;
+            struct gbm_bo *bo;
+
+            /// Exports of bo not yet released.
+            int32_t holds;
+        } slots[WGBM_WINDOW_MAX_BUFFERS];
+        int32_t head;
+        int32_t count;
+    } locked;
+
+    /// @brief The buffer mapped by waffle_window_map_front_buffer().
+    ///
+    /// Null if none. It is the newest locked buffer.
+    struct gbm_bo *mapped_bo;
+    void *map_data;
+    void *map_ptr;
+    uint32_t map_stride;
 };
 
 static inline struct wgbm_window*
@@ -56,6 +133,11 @@ wgbm_window_create(struct wcore_platform *wc_plat,
                    int32_t height,
                    const intptr_t attrib_list[]);
 
+struct wcore_window*
+wgbm_window_adopt_native(struct wcore_platform *wc_plat,
+                         struct wcore_config *wc_config,
+                         union waffle_native_window *native);
+
 bool
 wgbm_window_destroy(struct wcore_window *wc_self);
 
@@ -65,5 +147,28 @@ wgbm_window_show(struct wcore_window *wc_self);
 bool
 wgbm_window_swap_buffers(struct wcore_window *wc_self);
 
+bool
+wgbm_window_resize(struct wcore_window *wc_self,
+                   int32_t width, int32_t height);
+
 union waffle_native_window*
 wgbm_window_get_native(struct wcore_window *wc_self);
+
+bool
+wgbm_window_get_attrib(struct wcore_window *wc_self,
+                       int32_t attrib,
+                       intptr_t *value);
+
+bool
+wgbm_window_export_frame(struct wcore_window *wc_self,
+                         struct waffle_dmabuf *frame);
+
+bool
+wgbm_window_release_frame(struct wcore_window *wc_self);
+
+bool
+wgbm_window_map_front_buffer(struct wcore_window *wc_self,
+                             struct waffle_mapped_frame *frame);
+
+bool
+wgbm_window_unmap_front_buffer(struct wcore_window *wc_self);
@@ -74,6 +74,27 @@ glx_config_check_context_attrs(struct glx_display *dpy,
         return false;
     }
 
+    if (attrs->context_no_error && !dpy->ARB_create_context_no_error) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "GLX_ARB_create_context_no_error is required in order to "
+                     "request a no-error context");
+        return false;
+    }
+
+    if (attrs->context_release_behavior != WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH &&
+        !dpy->ARB_context_flush_control) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "GLX_ARB_context_flush_control is required in order to "
+                     "request a context release behavior");
+        return false;
+    }
+
+    if (attrs->context_priority != WAFFLE_CONTEXT_PRIORITY_MEDIUM) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "GLX does not support context priorities");
+        return false;
+    }
+
     switch (attrs->context_api) {
         case WAFFLE_CONTEXT_OPENGL:
             if (glx_context_needs_arb_create_context(attrs) &&
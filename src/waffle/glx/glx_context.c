@@ -37,6 +37,18 @@
 #define GLX_CONTEXT_PROFILE_MASK_ARB      0x9126
 #endif /* GLX_ARB_create_context_profile */
 
+#ifndef GLX_ARB_create_context_no_error
+#define GLX_ARB_create_context_no_error 1
+#define GLX_CONTEXT_OPENGL_NO_ERROR_ARB   0x31B3
+#endif
+
+#ifndef GLX_ARB_context_flush_control
+#define GLX_ARB_context_flush_control 1
+#define GLX_CONTEXT_RELEASE_BEHAVIOR_ARB   0x2097
+#define GLX_CONTEXT_RELEASE_BEHAVIOR_NONE_ARB 0
+#define GLX_CONTEXT_RELEASE_BEHAVIOR_FLUSH_ARB 0x2098
+#endif
+
 #include <assert.h>
 #include <stdlib.h>
 
@@ -155,6 +167,16 @@ glx_context_fill_attrib_list(struct glx_config *config,
         context_flags |= GLX_CONTEXT_ROBUST_ACCESS_BIT_ARB;
     }
 
+    if (attrs->context_no_error) {
+        attrib_list[i++] = GLX_CONTEXT_OPENGL_NO_ERROR_ARB;
+        attrib_list[i++] = True;
+    }
+
+    if (attrs->context_release_behavior == WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE) {
+        attrib_list[i++] = GLX_CONTEXT_RELEASE_BEHAVIOR_ARB;
+        attrib_list[i++] = GLX_CONTEXT_RELEASE_BEHAVIOR_NONE_ARB;
+    }
+
     if (context_flags != 0) {
         attrib_list[i++] = GLX_CONTEXT_FLAGS_ARB;
         attrib_list[i++] = context_flags;
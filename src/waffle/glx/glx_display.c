@@ -64,6 +64,8 @@ glx_display_set_extensions(struct glx_display *self)
     self->ARB_create_context                     = waffle_is_extension_in_string(s, "GLX_ARB_create_context");
     self->ARB_create_context_profile             = waffle_is_extension_in_string(s, "GLX_ARB_create_context_profile");
     self->ARB_create_context_robustness          = waffle_is_extension_in_string(s, "GLX_ARB_create_context_robustness");
+    self->ARB_create_context_no_error            = waffle_is_extension_in_string(s, "GLX_ARB_create_context_no_error");
+    self->ARB_context_flush_control              = waffle_is_extension_in_string(s, "GLX_ARB_context_flush_control");
     self->EXT_create_context_es_profile          = waffle_is_extension_in_string(s, "GLX_EXT_create_context_es_profile");
 
     // The GLX_EXT_create_context_es2_profile spec, version 4 2012/03/28,
@@ -113,6 +115,41 @@ error:
     return NULL;
 }
 
+struct wcore_display*
+glx_display_adopt_native(struct wcore_platform *wc_plat,
+                         union waffle_native_display *native)
+{
+    struct glx_display *self;
+    bool ok = true;
+
+    if (!native->glx) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "native->glx is null");
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (self == NULL)
+        return NULL;
+
+    ok = wcore_display_init(&self->wcore, wc_plat);
+    if (!ok)
+        goto error;
+
+    ok = x11_display_adopt(&self->x11, native->glx->xlib_display);
+    if (!ok)
+        goto error;
+
+    ok = glx_display_set_extensions(self);
+    if (!ok)
+        goto error;
+
+    return &self->wcore;
+
+error:
+    glx_display_destroy(&self->wcore);
+    return NULL;
+}
+
 bool
 glx_display_supports_context_api(struct wcore_display *wc_self,
                                  int32_t context_api)
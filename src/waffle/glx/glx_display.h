@@ -47,6 +47,8 @@ struct glx_display {
     bool ARB_create_context;
     bool ARB_create_context_profile;
     bool ARB_create_context_robustness;
+    bool ARB_create_context_no_error;
+    bool ARB_context_flush_control;
     bool EXT_create_context_es_profile;
     bool EXT_create_context_es2_profile;
 };
@@ -60,6 +62,10 @@ struct wcore_display*
 glx_display_connect(struct wcore_platform *wc_plat,
                     const char *name);
 
+struct wcore_display*
+glx_display_adopt_native(struct wcore_platform *wc_plat,
+                         union waffle_native_display *native);
+
 bool
 glx_display_destroy(struct wcore_display *wc_self);
 
@@ -0,0 +1,167 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wcore_context.h"
+#include "wcore_error.h"
+#include "wcore_tinfo.h"
+
+#include "glx_fence.h"
+#include "glx_platform.h"
+
+/// A GL sync object belongs to a share group, and GL calls act on the
+/// current context, so each fence call needs one.
+static bool
+glx_fence_check_current(void)
+{
+    if (!wcore_tinfo_get()->current_context) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "no context is current; GLX fences are GL sync "
+                     "objects, which need one");
+        return false;
+    }
+
+    return true;
+}
+
+/// True if the current context has sync objects, either from
+/// OpenGL 3.2, OpenGL ES 3.0 or GL_ARB_sync.
+static bool
+glx_fence_context_has_sync(struct glx_platform *plat)
+{
+    const char *version;
+    const char *extensions;
+    int major = 0, minor = 0;
+
+    if (!plat->glGetString)
+        return false;
+
+    version = (const char *) plat->glGetString(GL_VERSION);
+    if (!version)
+        return false;
+
+    if (strncmp(version, "OpenGL ES ", 10) == 0) {
+        sscanf(version + 10, "%d.%d", &major, &minor);
+        return major >= 3;
+    }
+
+    sscanf(version, "%d.%d", &major, &minor);
+    if (major > 3 || (major == 3 && minor >= 2))
+        return true;
+
+    // Before 3.2, GL_EXTENSIONS is still a valid glGetString query.
+    extensions = (const char *) plat->glGetString(GL_EXTENSIONS);
+    return waffle_is_extension_in_string(extensions, "GL_ARB_sync");
+}
+
+struct wcore_fence*
+glx_fence_create(struct wcore_context *wc_ctx)
+{
+    struct glx_platform *plat = glx_platform(wc_ctx->display->platform);
+    struct glx_fence *self;
+
+    // The API layer has checked that the context is current.
+    if (!plat->glFenceSync || !plat->glDeleteSync ||
+        !plat->glClientWaitSync || !plat->glWaitSync ||
+        !glx_fence_context_has_sync(plat)) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "the context lacks OpenGL 3.2, OpenGL ES 3.0 and "
+                     "GL_ARB_sync");
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (!self)
+        return NULL;
+
+    wcore_fence_init(&self->wcore, wc_ctx->display);
+
+    self->gl = plat->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (!self->gl) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "glFenceSync failed");
+        free(self);
+        return NULL;
+    }
+
+    return &self->wcore;
+}
+
+bool
+glx_fence_destroy(struct wcore_fence *wc_self)
+{
+    struct glx_fence *self = glx_fence(wc_self);
+    struct glx_platform *plat = glx_platform(wc_self->display->platform);
+    bool ok = true;
+
+    // Without a current context there is no share group to delete the sync
+    // object from. It is freed with its share group, so free only the
+    // waffle object.
+    if (wcore_tinfo_get()->current_context)
+        plat->glDeleteSync(self->gl);
+
+    ok &= wcore_fence_teardown(wc_self);
+    free(self);
+    return ok;
+}
+
+bool
+glx_fence_wait(struct wcore_fence *wc_self,
+               uint64_t timeout_ns,
+               bool *signaled)
+{
+    struct glx_fence *self = glx_fence(wc_self);
+    struct glx_platform *plat = glx_platform(wc_self->display->platform);
+    GLenum status;
+
+    if (!glx_fence_check_current())
+        return false;
+
+    // GL_TIMEOUT_IGNORED and WAFFLE_FENCE_FOREVER are both the largest value.
+    status = plat->glClientWaitSync(self->gl, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                    timeout_ns);
+    if (status == GL_WAIT_FAILED) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "glClientWaitSync failed");
+        return false;
+    }
+
+    *signaled = status != GL_TIMEOUT_EXPIRED;
+    return true;
+}
+
+bool
+glx_fence_server_wait(struct wcore_fence *wc_self)
+{
+    struct glx_fence *self = glx_fence(wc_self);
+    struct glx_platform *plat = glx_platform(wc_self->display->platform);
+
+    if (!glx_fence_check_current())
+        return false;
+
+    plat->glWaitSync(self->gl, 0, GL_TIMEOUT_IGNORED);
+    return true;
+}
@@ -0,0 +1,61 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <GL/glx.h>
+
+#include "wcore_fence.h"
+#include "wcore_util.h"
+
+struct wcore_context;
+
+struct glx_fence {
+    struct wcore_fence wcore;
+    GLsync gl;
+};
+
+DEFINE_CONTAINER_CAST_FUNC(glx_fence,
+                           struct glx_fence,
+                           struct wcore_fence,
+                           wcore)
+
+/// Requires GL_ARB_sync, or OpenGL 3.2, in the current context.
+struct wcore_fence*
+glx_fence_create(struct wcore_context *wc_ctx);
+
+bool
+glx_fence_destroy(struct wcore_fence *wc_self);
+
+bool
+glx_fence_wait(struct wcore_fence *wc_self,
+               uint64_t timeout_ns,
+               bool *signaled);
+
+bool
+glx_fence_server_wait(struct wcore_fence *wc_self);
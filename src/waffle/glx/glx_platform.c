@@ -33,6 +33,7 @@
 #include "glx_config.h"
 #include "glx_context.h"
 #include "glx_display.h"
+#include "glx_fence.h"
 #include "glx_platform.h"
 #include "glx_window.h"
 #include "glx_wrappers.h"
@@ -119,6 +120,11 @@ glx_platform_create(void)
         goto error;
 
     self->glXCreateContextAttribsARB = (PFNGLXCREATECONTEXTATTRIBSARBPROC) self->glXGetProcAddress((const uint8_t*) "glXCreateContextAttribsARB");
+    self->glGetString = (void*) self->glXGetProcAddress((const uint8_t*) "glGetString");
+    self->glFenceSync = (PFNGLFENCESYNCPROC) self->glXGetProcAddress((const uint8_t*) "glFenceSync");
+    self->glDeleteSync = (PFNGLDELETESYNCPROC) self->glXGetProcAddress((const uint8_t*) "glDeleteSync");
+    self->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC) self->glXGetProcAddress((const uint8_t*) "glClientWaitSync");
+    self->glWaitSync = (PFNGLWAITSYNCPROC) self->glXGetProcAddress((const uint8_t*) "glWaitSync");
 
     self->wcore.vtbl = &glx_platform_vtbl;
     return &self->wcore;
@@ -187,6 +193,7 @@ static const struct wcore_platform_vtbl glx_platform_vtbl = {
         .destroy = glx_display_destroy,
         .supports_context_api = glx_display_supports_context_api,
         .get_native = glx_display_get_native,
+        .adopt_native = glx_display_adopt_native,
     },
 
     .config = {
@@ -197,16 +204,28 @@ static const struct wcore_platform_vtbl glx_platform_vtbl = {
 
     .context = {
         .create = glx_context_create,
+        .create_no_config = NULL,
         .destroy = glx_context_destroy,
         .get_native = glx_context_get_native,
+        .get_attrib = NULL,
     },
 
     .window = {
         .create = glx_window_create,
+        .create_many = glx_window_create_many,
         .destroy = glx_window_destroy,
         .show = glx_window_show,
         .resize = glx_window_resize,
         .swap_buffers = glx_window_swap_buffers,
         .get_native = glx_window_get_native,
+        .get_attrib = glx_window_get_attrib,
+        .adopt_native = glx_window_adopt_native,
+    },
+
+    .fence = {
+        .create = glx_fence_create,
+        .destroy = glx_fence_destroy,
+        .wait = glx_fence_wait,
+        .server_wait = glx_fence_server_wait,
     },
 };
@@ -59,6 +59,14 @@ struct glx_platform {
 
 
     PFNGLXCREATECONTEXTATTRIBSARBPROC glXCreateContextAttribsARB;
+
+    // GL_ARB_sync, from glXGetProcAddress. glXGetProcAddress returns
+    // non-null for any name, so check the current context before use.
+    const GLubyte *(*glGetString)(GLenum name);
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLWAITSYNCPROC glWaitSync;
 };
 
 DEFINE_CONTAINER_CAST_FUNC(glx_platform,
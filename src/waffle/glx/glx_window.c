@@ -50,25 +50,101 @@ glx_window_destroy(struct wcore_window *wc_self)
     return ok;
 }
 
-struct wcore_window*
-glx_window_create(struct wcore_platform *wc_plat,
-                  struct wcore_config *wc_config,
-                  int32_t width,
-                  int32_t height,
-                  const intptr_t attrib_list[])
+bool
+glx_window_create_many(struct wcore_platform *wc_plat,
+                       struct wcore_config *wc_config,
+                       int32_t width,
+                       int32_t height,
+                       const intptr_t attrib_list[],
+                       int32_t count,
+                       struct wcore_window *windows[])
 {
     struct glx_window *self;
     struct glx_display *dpy = glx_display(wc_config->display);
     struct glx_config *config = glx_config(wc_config);
+    int32_t i;
+    bool fullscreen = width == -1 && height == -1;
     bool ok = true;
 
-    if (width == -1 && height == -1) {
+    if (fullscreen) {
         width = DisplayWidth(dpy->x11.xlib, dpy->x11.screen);
         height = DisplayHeight(dpy->x11.xlib, dpy->x11.screen);
     }
 
     if (wcore_attrib_list_length(attrib_list) > 0) {
         wcore_error_bad_attribute(attrib_list[0]);
+        return false;
+    }
+
+    for (i = 0; i < count; ++i)
+        windows[i] = NULL;
+
+    // Send every window's requests before waiting on any of them.
+    for (i = 0; i < count; ++i) {
+        self = wcore_calloc(sizeof(*self));
+        if (self == NULL)
+            goto error;
+
+        windows[i] = &self->wcore;
+
+        ok = wcore_window_init(&self->wcore, wc_config);
+        if (!ok)
+            goto error;
+
+        ok = x11_window_init_begin(&self->x11,
+                                   &dpy->x11,
+                                   config->xcb_visual_id,
+                                   width,
+                                   height,
+                                   fullscreen);
+        if (!ok)
+            goto error;
+    }
+
+    for (i = 0; i < count; ++i) {
+        ok = x11_window_init_finish(&glx_window(windows[i])->x11);
+        if (!ok)
+            goto error;
+    }
+
+    return true;
+
+error:
+    for (i = 0; i < count; ++i) {
+        glx_window_destroy(windows[i]);
+        windows[i] = NULL;
+    }
+    return false;
+}
+
+struct wcore_window*
+glx_window_create(struct wcore_platform *wc_plat,
+                  struct wcore_config *wc_config,
+                  int32_t width,
+                  int32_t height,
+                  const intptr_t attrib_list[])
+{
+    struct wcore_window *window;
+
+    if (!glx_window_create_many(wc_plat, wc_config, width, height,
+                                attrib_list, 1, &window))
+        return NULL;
+
+    return window;
+}
+
+struct wcore_window*
+glx_window_adopt_native(struct wcore_platform *wc_plat,
+                        struct wcore_config *wc_config,
+                        union waffle_native_window *native)
+{
+    struct glx_window *self;
+    struct glx_display *dpy = glx_display(wc_config->display);
+    struct glx_config *config = glx_config(wc_config);
+    bool ok = true;
+
+    if (!native->glx) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "native->glx is null");
         return NULL;
     }
 
@@ -80,11 +156,12 @@ glx_window_create(struct wcore_platform *wc_plat,
     if (!ok)
         goto error;
 
-    ok = x11_window_init(&self->x11,
-                         &dpy->x11,
-                         config->xcb_visual_id,
-                         width,
-                         height);
+    // The X window is itself the GLX drawable.
+    ok = x11_window_adopt(&self->x11,
+                          &dpy->x11,
+                          config->xcb_visual_id,
+                          native->glx->xlib_display,
+                          native->glx->xlib_window);
     if (!ok)
         goto error;
 
@@ -136,3 +213,11 @@ glx_window_get_native(struct wcore_window *wc_self)
 
     return n_window;
 }
+
+bool
+glx_window_get_attrib(struct wcore_window *wc_self,
+                      int32_t attrib,
+                      intptr_t *value)
+{
+    return x11_window_get_attrib(&glx_window(wc_self)->x11, attrib, value);
+}
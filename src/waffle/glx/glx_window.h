@@ -50,6 +50,20 @@ glx_window_create(struct wcore_platform *wc_plat,
                   int32_t height,
                   const intptr_t attrib_list[]);
 
+bool
+glx_window_create_many(struct wcore_platform *wc_plat,
+                       struct wcore_config *wc_config,
+                       int32_t width,
+                       int32_t height,
+                       const intptr_t attrib_list[],
+                       int32_t count,
+                       struct wcore_window *windows[]);
+
+struct wcore_window*
+glx_window_adopt_native(struct wcore_platform *wc_plat,
+                        struct wcore_config *wc_config,
+                        union waffle_native_window *native);
+
 bool
 glx_window_destroy(struct wcore_window *wc_self);
 
@@ -65,3 +79,8 @@ glx_window_swap_buffers(struct wcore_window *wc_self);
 
 union waffle_native_window*
 glx_window_get_native(struct wcore_window *wc_self);
+
+bool
+glx_window_get_attrib(struct wcore_window *wc_self,
+                      int32_t attrib,
+                      intptr_t *value);
@@ -0,0 +1,105 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#define _DEFAULT_SOURCE // major(), minor()
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "waffle.h"
+
+#include "linux_device.h"
+
+/// Return the hexadecimal value of a sysfs attribute, or 0.
+static uint32_t
+linux_device_read_hex(const char *dir, const char *attr)
+{
+    char path[PATH_MAX];
+    unsigned value = 0;
+    FILE *file;
+
+    snprintf(path, sizeof(path), "%s/%s", dir, attr);
+
+    file = fopen(path, "re");
+    if (!file)
+        return 0;
+
+    if (fscanf(file, "%x", &value) != 1)
+        value = 0;
+
+    fclose(file);
+    return value;
+}
+
+void
+linux_device_report(struct waffle_device_info devices[],
+                    int32_t max_devices,
+                    int32_t *num_devices,
+                    const char *node)
+{
+    struct waffle_device_info *info;
+    char dir[64];
+    char path[PATH_MAX];
+    char target[PATH_MAX];
+    const char *driver;
+    struct stat st;
+    ssize_t len;
+
+    if (!devices || *num_devices >= max_devices) {
+        ++*num_devices;
+        return;
+    }
+
+    info = &devices[(*num_devices)++];
+    memset(info, 0, sizeof(*info));
+    snprintf(info->name, sizeof(info->name), "%s", node);
+
+    if (stat(node, &st) != 0 || !S_ISCHR(st.st_mode))
+        return;
+
+    snprintf(dir, sizeof(dir), "/sys/dev/char/%u:%u/device",
+             major(st.st_rdev), minor(st.st_rdev));
+
+    // Devices that are not on PCI lack these attributes.
+    info->pci_vendor_id = linux_device_read_hex(dir, "vendor");
+    info->pci_device_id = linux_device_read_hex(dir, "device");
+
+    snprintf(path, sizeof(path), "%s/driver", dir);
+    len = readlink(path, target, sizeof(target) - 1);
+    if (len <= 0)
+        return;
+
+    target[len] = '\0';
+    driver = strrchr(target, '/');
+    driver = driver ? driver + 1 : target;
+
+    // The entry is zeroed, so this terminates the name.
+    strncpy(info->driver, driver, sizeof(info->driver) - 1);
+}
@@ -69,6 +69,24 @@ nacl_config_choose(struct wcore_platform *wc_plat,
         goto error;
     }
 
+    if (attrs->context_no_error) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "NaCl does not support no-error contexts.");
+        goto error;
+    }
+
+    if (attrs->context_priority != WAFFLE_CONTEXT_PRIORITY_MEDIUM) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "NaCl does not support context priorities.");
+        goto error;
+    }
+
+    if (attrs->context_release_behavior != WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "NaCl does not support context release behaviors.");
+        goto error;
+    }
+
     unsigned attr = 0;
 
     // Max amount of attribs is hardcoded in nacl_config.h (64)
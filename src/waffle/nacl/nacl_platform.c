@@ -99,12 +99,14 @@ static const struct wcore_platform_vtbl nacl_platform_vtbl = {
     .make_current = nacl_platform_make_current,
     .dl_can_open = nacl_dl_can_open,
     .dl_sym = nacl_dl_sym,
+    .enumerate_devices = NULL,
 
     .display = {
         .connect = nacl_display_connect,
         .destroy = nacl_display_destroy,
         .supports_context_api = nacl_display_supports_context_api,
         .get_native = NULL,
+        .adopt_native = NULL,
     },
 
     .config = {
@@ -115,8 +117,10 @@ static const struct wcore_platform_vtbl nacl_platform_vtbl = {
 
     .context = {
         .create = nacl_context_create,
+        .create_no_config = NULL,
         .destroy = nacl_context_destroy,
         .get_native = NULL,
+        .get_attrib = NULL,
     },
 
     .window = {
@@ -126,5 +130,28 @@ static const struct wcore_platform_vtbl nacl_platform_vtbl = {
         .swap_buffers = nacl_window_swap_buffers,
         .resize = nacl_window_resize,
         .get_native = NULL,
+        .create_many = NULL,
+        .get_attrib = NULL,
+        .adopt_native = NULL,
+        .export_frame = NULL,
+        .release_frame = NULL,
+        .map_front_buffer = NULL,
+        .unmap_front_buffer = NULL,
+    },
+
+    .image = {
+        .create_from_dmabuf = NULL,
+        .create_from_texture = NULL,
+        .destroy = NULL,
+        .bind_texture = NULL,
+        .export_dmabuf = NULL,
+    },
+
+    .fence = {
+        .create = NULL,
+        .destroy = NULL,
+        .wait = NULL,
+        .server_wait = NULL,
+        .export_fd = NULL,
     },
 };
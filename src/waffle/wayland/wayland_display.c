@@ -23,14 +23,21 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#define _GNU_SOURCE
 #define WL_EGL_PLATFORM 1
 
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 // The wrapper must be included before wayland-client.h
 #include "wayland_wrapper.h"
 #include <wayland-client.h>
+#include "viewporter-client-protocol.h"
+#include "xdg-shell-client-protocol.h"
 #undef container_of
 
 #include "wcore_error.h"
@@ -41,6 +48,27 @@
 #include "wayland_display.h"
 #include "wayland_platform.h"
 
+static void
+dispatch_thread_stop(struct wayland_display *self)
+{
+    const char c = 0;
+
+    if (!self->dispatch.running)
+        return;
+
+    // Wake the thread from poll(). It exits without touching wl_queue again.
+    while (write(self->dispatch.wake_fds[1], &c, 1) < 0 && errno == EINTR)
+        continue;
+
+    thrd_join(self->dispatch.thread, NULL);
+    self->dispatch.running = false;
+
+    cnd_destroy(&self->dispatch.cond);
+    mtx_destroy(&self->dispatch.mutex);
+    close(self->dispatch.wake_fds[0]);
+    close(self->dispatch.wake_fds[1]);
+}
+
 bool
 wayland_display_destroy(struct wcore_display *wc_self)
 {
@@ -52,13 +80,53 @@ wayland_display_destroy(struct wcore_display *wc_self)
 
     ok &= wegl_display_teardown(&self->wegl);
 
-    if (self->wl_display)
+    dispatch_thread_stop(self);
+
+    if (self->wp_viewporter)
+        wp_viewporter_destroy(self->wp_viewporter);
+
+    if (self->xdg_wm_base)
+        xdg_wm_base_destroy(self->xdg_wm_base);
+
+    if (self->wl_subcompositor)
+        wl_subcompositor_destroy(self->wl_subcompositor);
+
+    if (self->wl_shell)
+        wl_shell_destroy(self->wl_shell);
+
+    if (self->wl_compositor)
+        wl_compositor_destroy(self->wl_compositor);
+
+    if (self->wl_registry)
+        wl_registry_destroy(self->wl_registry);
+
+#ifdef WAFFLE_HAS_WL_PROXY_WRAPPER
+    if (self->wl_display_wrapper)
+        wl_proxy_wrapper_destroy(self->wl_display_wrapper);
+#endif
+
+    if (self->wl_queue)
+        wl_event_queue_destroy(self->wl_queue);
+
+    if (self->wl_display && !self->adopted)
         wl_display_disconnect(self->wl_display);
 
     free(self);
     return ok;
 }
 
+static void
+xdg_wm_base_listener_ping(void *data,
+                          struct xdg_wm_base *xdg_wm_base,
+                          uint32_t serial)
+{
+    xdg_wm_base_pong(xdg_wm_base, serial);
+}
+
+static const struct xdg_wm_base_listener xdg_wm_base_listener = {
+    .ping = xdg_wm_base_listener_ping,
+};
+
 static void
 registry_listener_global(void *data,
                          struct wl_registry *registry,
@@ -76,6 +144,22 @@ registry_listener_global(void *data,
         self->wl_shell = wl_registry_bind(self->wl_registry, name,
                                           &wl_shell_interface, 1);
     }
+    else if (!strncmp(interface, "wl_subcompositor", 17)) {
+        self->wl_subcompositor = wl_registry_bind(self->wl_registry, name,
+                                                  &wl_subcompositor_interface,
+                                                  1);
+    }
+    else if (!strncmp(interface, "xdg_wm_base", 12)) {
+        self->xdg_wm_base = wl_registry_bind(self->wl_registry, name,
+                                             &xdg_wm_base_interface, 1);
+        if (self->xdg_wm_base)
+            xdg_wm_base_add_listener(self->xdg_wm_base,
+                                     &xdg_wm_base_listener, NULL);
+    }
+    else if (!strncmp(interface, "wp_viewporter", 14)) {
+        self->wp_viewporter = wl_registry_bind(self->wl_registry, name,
+                                               &wp_viewporter_interface, 1);
+    }
 }
 
 static void
@@ -90,28 +174,149 @@ static const struct wl_registry_listener registry_listener = {
     .global_remove = registry_listener_global_remove
 };
 
-struct wcore_display*
-wayland_display_connect(struct wcore_platform *wc_plat,
-                        const char *name)
+/// Dispatch wl_queue until the thread is woken through dispatch.wake_fds.
+static int
+dispatch_thread_main(void *data)
+{
+    struct wayland_display *self = data;
+    struct wl_display *wl_dpy = self->wl_display;
+    struct pollfd fds[2] = {
+        { .fd = wl_display_get_fd(wl_dpy), .events = POLLIN },
+        { .fd = self->dispatch.wake_fds[0], .events = POLLIN },
+    };
+    int ret;
+
+    while (true) {
+        mtx_lock(&self->dispatch.mutex);
+        while (wl_display_prepare_read_queue(wl_dpy, self->wl_queue) != 0) {
+            if (wl_display_dispatch_queue_pending(wl_dpy, self->wl_queue) < 0) {
+                mtx_unlock(&self->dispatch.mutex);
+                goto error;
+            }
+        }
+        mtx_unlock(&self->dispatch.mutex);
+
+        // EAGAIN only means the socket is full; the next iteration retries.
+        wl_display_flush(wl_dpy);
+
+        ret = poll(fds, 2, -1);
+        if (ret < 0) {
+            wl_display_cancel_read(wl_dpy);
+            if (errno == EINTR)
+                continue;
+            goto error;
+        }
+
+        if (fds[1].revents) {
+            wl_display_cancel_read(wl_dpy);
+            return 0;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            if (wl_display_read_events(wl_dpy) < 0)
+                goto error;
+        }
+        else {
+            wl_display_cancel_read(wl_dpy);
+            if (fds[0].revents & (POLLERR | POLLHUP))
+                goto error;
+        }
+
+        mtx_lock(&self->dispatch.mutex);
+        ret = wl_display_dispatch_queue_pending(wl_dpy, self->wl_queue);
+        mtx_unlock(&self->dispatch.mutex);
+        if (ret < 0)
+            goto error;
+    }
+
+error:
+    mtx_lock(&self->dispatch.mutex);
+    self->dispatch.failed = true;
+    cnd_broadcast(&self->dispatch.cond);
+    mtx_unlock(&self->dispatch.mutex);
+    return -1;
+}
+
+static bool
+dispatch_thread_start(struct wayland_display *self)
+{
+#ifdef WAFFLE_HAS_WL_PROXY_WRAPPER
+    if (pipe2(self->dispatch.wake_fds, O_CLOEXEC) != 0) {
+        wcore_error_errno("pipe2 failed");
+        return false;
+    }
+
+    if (mtx_init(&self->dispatch.mutex, mtx_plain) != thrd_success)
+        goto error_mutex;
+
+    if (cnd_init(&self->dispatch.cond) != thrd_success)
+        goto error_cond;
+
+    if (thrd_create(&self->dispatch.thread, dispatch_thread_main,
+                    self) != thrd_success)
+        goto error_thread;
+
+    self->dispatch.running = true;
+    return true;
+
+error_thread:
+    cnd_destroy(&self->dispatch.cond);
+error_cond:
+    mtx_destroy(&self->dispatch.mutex);
+error_mutex:
+    close(self->dispatch.wake_fds[0]);
+    close(self->dispatch.wake_fds[1]);
+    wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                 "failed to start wayland dispatch thread");
+    return false;
+#else
+    wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                 "WAFFLE_WAYLAND_DISPATCH_THREAD requires wayland >= 1.11");
+    return false;
+#endif
+}
+
+static bool
+dispatch_thread_requested(void)
+{
+    const char *env = getenv("WAFFLE_WAYLAND_DISPATCH_THREAD");
+    return env && env[0] && strcmp(env, "0") != 0;
+}
+
+/// Bind waffle's globals on a private queue of the connected wl_display.
+static bool
+wayland_display_init(struct wayland_display *self,
+                     struct wcore_platform *wc_plat)
 {
-    struct wayland_display *self;
-    bool ok = true;
     int error = 0;
 
-    self = wcore_calloc(sizeof(*self));
-    if (self == NULL)
-        return NULL;
+    self->wl_queue = wl_display_create_queue(self->wl_display);
+    if (!self->wl_queue) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wl_display_create_queue failed");
+        return false;
+    }
 
-    self->wl_display = wl_display_connect(name);
-    if (!self->wl_display) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wl_display_connect failed");
-        goto error;
+    // The registry, and therefore every proxy waffle later creates from the
+    // globals it binds, lives on the private queue.
+#ifdef WAFFLE_HAS_WL_PROXY_WRAPPER
+    self->wl_display_wrapper = wl_proxy_create_wrapper(self->wl_display);
+    if (!self->wl_display_wrapper) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wl_proxy_create_wrapper failed");
+        return false;
     }
+    wl_proxy_set_queue((struct wl_proxy *) self->wl_display_wrapper,
+                       self->wl_queue);
 
+    self->wl_registry = wl_display_get_registry(self->wl_display_wrapper);
+#else
     self->wl_registry = wl_display_get_registry(self->wl_display);
+    if (self->wl_registry)
+        wl_proxy_set_queue((struct wl_proxy *) self->wl_registry,
+                           self->wl_queue);
+#endif
     if (!self->wl_registry) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wl_display_get_registry failed");
-        goto error;
+        return false;
     }
 
     error = wl_registry_add_listener(self->wl_registry,
@@ -119,30 +324,89 @@ wayland_display_connect(struct wcore_platform *wc_plat,
                                      self);
     if (error < 0) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wl_registry_add_listener failed");
-        goto error;
+        return false;
     }
 
     // Block until the Wayland server has processed all pending requests and
     // has sent out pending events on all event queues. This should ensure
     // that the registry listener has received announcement of the shell and
     // compositor.
-    ok = wayland_display_sync(self);
-    if (!ok)
-        goto error;
+    if (!wayland_display_sync(self))
+        return false;
 
     if (!self->wl_compositor) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "failed to bind to the wayland "
                      "compositor");
-        goto error;
+        return false;
     }
 
-    if (!self->wl_shell) {
+    if (!self->xdg_wm_base && !self->wl_shell) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "failed to bind to the wayland "
                      "shell");
+        return false;
+    }
+
+    if (!wegl_display_init(&self->wegl, wc_plat, (intptr_t) self->wl_display))
+        return false;
+
+    if (dispatch_thread_requested())
+        return dispatch_thread_start(self);
+
+    return true;
+}
+
+struct wcore_display*
+wayland_display_connect(struct wcore_platform *wc_plat,
+                        const char *name)
+{
+    struct wayland_display *self;
+    bool ok = true;
+
+    self = wcore_calloc(sizeof(*self));
+    if (self == NULL)
+        return NULL;
+
+    self->wl_display = wl_display_connect(name);
+    if (!self->wl_display) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wl_display_connect failed");
+        goto error;
+    }
+
+    ok = wayland_display_init(self, wc_plat);
+    if (!ok)
         goto error;
+
+    return &self->wegl.wcore;
+
+error:
+    wayland_display_destroy(&self->wegl.wcore);
+    return NULL;
+}
+
+struct wcore_display*
+wayland_display_adopt_native(struct wcore_platform *wc_plat,
+                             union waffle_native_display *native)
+{
+    struct wayland_display *self;
+    bool ok = true;
+
+    if (!native->wayland || !native->wayland->wl_display) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "native->wayland->wl_display is null");
+        return NULL;
     }
 
-    ok = wegl_display_init(&self->wegl, wc_plat, (intptr_t) self->wl_display);
+    self = wcore_calloc(sizeof(*self));
+    if (self == NULL)
+        return NULL;
+
+    // Waffle still binds its own compositor and shell, but on its private
+    // queue of the application's connection.
+    self->wl_display = native->wayland->wl_display;
+    self->adopted = true;
+    self->wegl.adopted = true;
+
+    ok = wayland_display_init(self, wc_plat);
     if (!ok)
         goto error;
 
@@ -178,13 +442,175 @@ wayland_display_get_native(struct wcore_display *wc_self)
     return n_dpy;
 }
 
+#ifdef WAFFLE_HAS_WL_PROXY_WRAPPER
+struct sync_request {
+    struct wayland_display *dpy;
+    bool done;
+};
+
+static void
+sync_callback_done(void *data, struct wl_callback *callback, uint32_t serial)
+{
+    struct sync_request *req = data;
+
+    // Called by the dispatch thread, which holds dispatch.mutex.
+    req->done = true;
+    cnd_broadcast(&req->dpy->dispatch.cond);
+}
+
+static const struct wl_callback_listener sync_callback_listener = {
+    .done = sync_callback_done,
+};
+
+/// Roundtrip while the dispatch thread owns wl_queue.
+static bool
+wayland_display_sync_threaded(struct wayland_display *dpy)
+{
+    struct sync_request req = { .dpy = dpy, .done = false };
+    struct wl_callback *callback;
+    bool ok = true;
+
+    // Holding the mutex keeps the thread from dispatching the callback's
+    // done event before its listener is attached.
+    mtx_lock(&dpy->dispatch.mutex);
+
+    callback = wl_display_sync(dpy->wl_display_wrapper);
+    if (!callback) {
+        mtx_unlock(&dpy->dispatch.mutex);
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wl_display_sync failed");
+        return false;
+    }
+    wl_callback_add_listener(callback, &sync_callback_listener, &req);
+
+    if (wl_display_flush(dpy->wl_display) < 0 && errno != EAGAIN) {
+        wcore_error_errno("error on wl_display");
+        ok = false;
+    }
+
+    while (ok && !req.done && !dpy->dispatch.failed) {
+        if (cnd_wait(&dpy->dispatch.cond, &dpy->dispatch.mutex) != thrd_success)
+            ok = false;
+    }
+
+    // The thread failed and exited, so roundtrip on this thread instead.
+    if (ok && !req.done &&
+        wl_display_roundtrip_queue(dpy->wl_display, dpy->wl_queue) == -1) {
+        wcore_error_errno("error on wl_display");
+        ok = false;
+    }
+
+    wl_callback_destroy(callback);
+    mtx_unlock(&dpy->dispatch.mutex);
+    return ok;
+}
+#endif
+
+/// True if the dispatch thread is dispatching wl_queue.
+static bool
+dispatch_thread_alive(struct wayland_display *dpy)
+{
+    bool alive;
+
+    if (!dpy->dispatch.running)
+        return false;
+
+    mtx_lock(&dpy->dispatch.mutex);
+    alive = !dpy->dispatch.failed;
+    mtx_unlock(&dpy->dispatch.mutex);
+    return alive;
+}
+
 bool
 wayland_display_sync(struct wayland_display *dpy)
 {
-    if (wl_display_roundtrip(dpy->wl_display) == -1) {
+    bool ok = true;
+
+#ifdef WAFFLE_HAS_WL_PROXY_WRAPPER
+    if (dispatch_thread_alive(dpy))
+        return wayland_display_sync_threaded(dpy);
+#endif
+
+    // If the dispatch thread failed, then the mutex still excludes other
+    // threads' listeners.
+    wayland_display_lock(dpy);
+    if (wl_display_roundtrip_queue(dpy->wl_display, dpy->wl_queue) == -1) {
         wcore_error_errno("error on wl_display");
-        return false;
+        ok = false;
+    }
+    wayland_display_unlock(dpy);
+
+    return ok;
+}
+
+void
+wayland_display_lock(struct wayland_display *dpy)
+{
+    if (dpy->dispatch.running)
+        mtx_lock(&dpy->dispatch.mutex);
+}
+
+void
+wayland_display_unlock(struct wayland_display *dpy)
+{
+    if (dpy->dispatch.running)
+        mtx_unlock(&dpy->dispatch.mutex);
+}
+
+/// Dispatch wl_queue on the calling thread.
+static bool
+dispatch_pending_here(struct wayland_display *dpy)
+{
+    struct wl_display *wl_dpy = dpy->wl_display;
+    struct pollfd pfd = {
+        .fd = wl_display_get_fd(wl_dpy),
+        .events = POLLIN,
+    };
+
+    while (wl_display_prepare_read_queue(wl_dpy, dpy->wl_queue) != 0) {
+        if (wl_display_dispatch_queue_pending(wl_dpy, dpy->wl_queue) < 0)
+            goto error;
+    }
+
+    if (wl_display_flush(wl_dpy) < 0 && errno != EAGAIN) {
+        wl_display_cancel_read(wl_dpy);
+        goto error;
+    }
+
+    if (poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN)) {
+        if (wl_display_read_events(wl_dpy) < 0)
+            goto error;
+    }
+    else {
+        wl_display_cancel_read(wl_dpy);
     }
 
+    if (wl_display_dispatch_queue_pending(wl_dpy, dpy->wl_queue) < 0)
+        goto error;
+
     return true;
+
+error:
+    wcore_error_errno("error on wl_display");
+    return false;
+}
+
+bool
+wayland_display_dispatch_pending(struct wayland_display *dpy)
+{
+    bool ok;
+
+    if (dispatch_thread_alive(dpy)) {
+        if (wl_display_flush(dpy->wl_display) < 0 && errno != EAGAIN) {
+            wcore_error_errno("error on wl_display");
+            return false;
+        }
+        return true;
+    }
+
+    // Once the dispatch thread has failed, nothing else reads the socket.
+    wayland_display_lock(dpy);
+    ok = dispatch_pending_here(dpy);
+    wayland_display_unlock(dpy);
+
+    return ok;
 }
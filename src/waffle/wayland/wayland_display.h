@@ -38,14 +38,55 @@
 struct wcore_platform;
 struct wl_display;
 struct wl_compositor;
+struct wl_event_queue;
 struct wl_shell;
+struct wl_subcompositor;
+struct wp_viewporter;
+struct xdg_wm_base;
 
 struct wayland_display {
     struct wl_display *wl_display;
+
+    /// The wl_display belongs to the application and is not disconnected.
+    bool adopted;
+
     struct wl_registry *wl_registry;
     struct wl_compositor *wl_compositor;
     struct wl_shell *wl_shell;
 
+    /// Null if the compositor does not support subsurfaces.
+    struct wl_subcompositor *wl_subcompositor;
+
+    /// Preferred over wl_shell when the compositor advertises it.
+    struct xdg_wm_base *xdg_wm_base;
+
+    /// Null if the compositor cannot scale surfaces.
+    struct wp_viewporter *wp_viewporter;
+
+    /// @brief Private queue on which all of waffle's proxies live.
+    ///
+    /// Waffle never dispatches the application's default queue, and the
+    /// application never dispatches waffle's events.
+    struct wl_event_queue *wl_queue;
+
+    /// @brief Wrapper of wl_display whose child proxies are assigned to
+    /// wl_queue atomically on creation. Null if libwayland lacks proxy
+    /// wrappers.
+    struct wl_display *wl_display_wrapper;
+
+    /// @brief Optional thread that dispatches wl_queue in the background.
+    ///
+    /// Enabled with the environment variable WAFFLE_WAYLAND_DISPATCH_THREAD.
+    /// While the thread runs, wl_queue is dispatched only with @a mutex held.
+    struct {
+        bool running;
+        bool failed;
+        thrd_t thread;
+        mtx_t mutex;
+        cnd_t cond;
+        int wake_fds[2];
+    } dispatch;
+
     struct wegl_display wegl;
 };
 
@@ -65,6 +106,10 @@ struct wcore_display*
 wayland_display_connect(struct wcore_platform *wc_plat,
                         const char *name);
 
+struct wcore_display*
+wayland_display_adopt_native(struct wcore_platform *wc_plat,
+                             union waffle_native_display *native);
+
 bool
 wayland_display_destroy(struct wcore_display *wc_self);
 
@@ -90,3 +135,23 @@ wayland_display_get_native(struct wcore_display *wc_self);
 /// public entry points synchronous.
 bool
 wayland_display_sync(struct wayland_display *dpy);
+
+/// @brief Flush requests and dispatch any events already sent by the server.
+///
+/// Unlike wayland_display_sync(), this never blocks waiting on the server.
+/// It is intended for the per-frame path, where a full roundtrip would
+/// serialize the client with the compositor.
+///
+/// While the dispatch thread runs, this only flushes. After the thread has
+/// failed, this dispatches on the calling thread, as it does without one.
+bool
+wayland_display_dispatch_pending(struct wayland_display *dpy);
+
+/// @brief Exclude the dispatch thread, if any, from running listeners.
+///
+/// State written by listeners must be read between these calls.
+void
+wayland_display_lock(struct wayland_display *dpy);
+
+void
+wayland_display_unlock(struct wayland_display *dpy);
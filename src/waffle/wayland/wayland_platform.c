@@ -37,6 +37,8 @@
 
 #include "wegl_config.h"
 #include "wegl_context.h"
+#include "wegl_fence.h"
+#include "wegl_image.h"
 #include "wegl_platform.h"
 #include "wegl_util.h"
 
@@ -193,12 +195,14 @@ static const struct wcore_platform_vtbl wayland_platform_vtbl = {
     .get_proc_address = wegl_get_proc_address,
     .dl_can_open = wayland_dl_can_open,
     .dl_sym = wayland_dl_sym,
+    .enumerate_devices = wegl_platform_enumerate_devices,
 
     .display = {
         .connect = wayland_display_connect,
         .destroy = wayland_display_destroy,
         .supports_context_api = wegl_display_supports_context_api,
         .get_native = wayland_display_get_native,
+        .adopt_native = wayland_display_adopt_native,
     },
 
     .config = {
@@ -209,8 +213,10 @@ static const struct wcore_platform_vtbl wayland_platform_vtbl = {
 
     .context = {
         .create = wegl_context_create,
+        .create_no_config = wegl_context_create_no_config,
         .destroy = wegl_context_destroy,
         .get_native = wayland_context_get_native,
+        .get_attrib = wegl_context_get_attrib,
     },
 
     .window = {
@@ -220,5 +226,22 @@ static const struct wcore_platform_vtbl wayland_platform_vtbl = {
         .swap_buffers = wayland_window_swap_buffers,
         .resize = wayland_window_resize,
         .get_native = wayland_window_get_native,
+        .adopt_native = wayland_window_adopt_native,
+    },
+
+    .image = {
+        .create_from_dmabuf = wegl_image_create_from_dmabuf,
+        .create_from_texture = wegl_image_create_from_texture,
+        .destroy = wegl_image_destroy,
+        .bind_texture = wegl_image_bind_texture,
+        .export_dmabuf = wegl_image_export_dmabuf,
+    },
+
+    .fence = {
+        .create = wegl_fence_create,
+        .destroy = wegl_fence_destroy,
+        .wait = wegl_fence_wait,
+        .server_wait = wegl_fence_server_wait,
+        .export_fd = wegl_fence_export_fd,
     },
 };
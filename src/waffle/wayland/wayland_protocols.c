@@ -0,0 +1,54 @@
+// Copyright 2016 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/// @file
+/// @brief Private code generated by wayland-scanner for extension protocols.
+///
+/// The generated code refers to the core interfaces that a protocol builds on
+/// (wl_surface, wl_output, ...) as data symbols exported by
+/// libwayland-client. Waffle does not link to libwayland-client, it loads it
+/// at runtime, so those references are redirected to local placeholders.
+///
+/// Only the client side of the interface tables is used. On the client,
+/// libwayland reads the types of object arguments in incoming events, never in
+/// outgoing requests, and compares interfaces by name. None of the protocols
+/// below send core objects in events, so a placeholder carrying the name is
+/// sufficient.
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "wayland-util.h"
+
+#define wl_output_interface waffle_wl_output_interface
+#define wl_seat_interface waffle_wl_seat_interface
+#define wl_surface_interface waffle_wl_surface_interface
+
+#include "viewporter-protocol.c"
+#include "xdg-shell-protocol.c"
+
+const struct wl_interface waffle_wl_output_interface = { .name = "wl_output" };
+const struct wl_interface waffle_wl_seat_interface = { .name = "wl_seat" };
+const struct wl_interface waffle_wl_surface_interface = { .name = "wl_surface" };
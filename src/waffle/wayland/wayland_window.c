@@ -31,6 +31,8 @@
 // The wrapper must be included before wayland-(client|egl).h
 #include "wayland_wrapper.h"
 #include <wayland-egl.h>
+#include "viewporter-client-protocol.h"
+#include "xdg-shell-client-protocol.h"
 #undef container_of
 
 #include "waffle_wayland.h"
@@ -44,32 +46,69 @@
 #include "wayland_platform.h"
 #include "wayland_window.h"
 
-bool
-wayland_window_destroy(struct wcore_window *wc_self)
+/// Size of a fullscreen window whose compositor leaves the size to waffle.
+enum {
+    WAYLAND_WINDOW_DEFAULT_WIDTH = 640,
+    WAYLAND_WINDOW_DEFAULT_HEIGHT = 480,
+};
+
+/// Destroy the window. It may have failed creation before
+/// wegl_window_init(), so the platform and display are passed in rather than
+/// taken from the window.
+static bool
+wayland_window_free(struct wayland_window *self,
+                    struct wayland_platform *plat,
+                    struct wayland_display *dpy)
 {
-    struct wcore_platform *wc_plat = wc_self->display->platform;
-    struct wayland_platform *plat = wayland_platform(wegl_platform(wc_plat));
-    struct wayland_window *self = wayland_window(wc_self);
     bool ok = true;
 
-    if (!self)
-        return ok;
-
     ok &= wegl_window_teardown(&self->wegl);
 
-    if (self->wl_window)
+    if (self->wl_window && !self->adopted_wl_window)
         plat->wl_egl_window_destroy(self->wl_window);
 
+    // The dispatch thread may be running a listener of the window. Destroying
+    // a proxy does not stop an event that is already being dispatched.
+    wayland_display_lock(dpy);
+
+    if (self->wp_viewport)
+        wp_viewport_destroy(self->wp_viewport);
+
+    if (self->xdg_toplevel)
+        xdg_toplevel_destroy(self->xdg_toplevel);
+
+    if (self->xdg_surface)
+        xdg_surface_destroy(self->xdg_surface);
+
     if (self->wl_shell_surface)
         wl_shell_surface_destroy(self->wl_shell_surface);
 
-    if (self->wl_surface)
+    if (self->wl_subsurface)
+        wl_subsurface_destroy(self->wl_subsurface);
+
+    if (self->wl_surface && !self->adopted)
         wl_surface_destroy(self->wl_surface);
 
     free(self);
+
+    wayland_display_unlock(dpy);
     return ok;
 }
 
+bool
+wayland_window_destroy(struct wcore_window *wc_self)
+{
+    struct wayland_window *self = wayland_window(wc_self);
+    struct wcore_platform *wc_plat;
+
+    if (!self)
+        return true;
+
+    wc_plat = wc_self->display->platform;
+    return wayland_window_free(self, wayland_platform(wegl_platform(wc_plat)),
+                               wayland_display(wc_self->display));
+}
+
 static void
 shell_surface_listener_ping(void *data,
                             struct wl_shell_surface *shell_surface,
@@ -99,6 +138,175 @@ static const struct wl_shell_surface_listener shell_surface_listener = {
     .popup_done = shell_surface_listener_popup_done
 };
 
+static void
+xdg_surface_listener_configure(void *data,
+                               struct xdg_surface *xdg_surface,
+                               uint32_t serial)
+{
+    struct wayland_window *self = data;
+
+    self->configure.pending = true;
+    self->configure.serial = serial;
+}
+
+static const struct xdg_surface_listener xdg_surface_listener = {
+    .configure = xdg_surface_listener_configure,
+};
+
+static void
+xdg_toplevel_listener_configure(void *data,
+                                struct xdg_toplevel *xdg_toplevel,
+                                int32_t width,
+                                int32_t height,
+                                struct wl_array *states)
+{
+    struct wayland_window *self = data;
+
+    self->configure.width = width;
+    self->configure.height = height;
+}
+
+static void
+xdg_toplevel_listener_close(void *data,
+                            struct xdg_toplevel *xdg_toplevel)
+{
+}
+
+static const struct xdg_toplevel_listener xdg_toplevel_listener = {
+    .configure = xdg_toplevel_listener_configure,
+    .close = xdg_toplevel_listener_close,
+};
+
+/// Acknowledge the last xdg configure event. A fullscreen window takes the
+/// size chosen by the compositor, either by resizing its buffer or, if it has
+/// a render size, by scaling it; other windows keep the size requested by
+/// the user.
+static void
+wayland_window_apply_configure(struct wayland_window *self)
+{
+    struct wcore_platform *wc_plat = self->wegl.wcore.display->platform;
+    struct wayland_platform *plat = wayland_platform(wegl_platform(wc_plat));
+    struct wayland_display *dpy = wayland_display(self->wegl.wcore.display);
+
+    wayland_display_lock(dpy);
+
+    if (self->configure.pending) {
+        if (self->fullscreen && self->wl_window &&
+            self->configure.width > 0 && self->configure.height > 0) {
+            if (self->wp_viewport) {
+                wp_viewport_set_destination(self->wp_viewport,
+                                            self->configure.width,
+                                            self->configure.height);
+            }
+            else {
+                plat->wl_egl_window_resize(self->wl_window,
+                                           self->configure.width,
+                                           self->configure.height, 0, 0);
+            }
+        }
+
+        xdg_surface_ack_configure(self->xdg_surface, self->configure.serial);
+        self->configure.pending = false;
+    }
+
+    wayland_display_unlock(dpy);
+}
+
+/// Give the surface the xdg_toplevel role and wait for the compositor's
+/// initial configure, which must precede the first buffer.
+static bool
+wayland_window_create_xdg_toplevel(struct wayland_window *self,
+                                   struct wayland_display *dpy)
+{
+    // Keep the dispatch thread from dispatching the initial configure before
+    // the listeners are attached.
+    wayland_display_lock(dpy);
+
+    self->xdg_surface = xdg_wm_base_get_xdg_surface(dpy->xdg_wm_base,
+                                                    self->wl_surface);
+    if (!self->xdg_surface) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                     "xdg_wm_base_get_xdg_surface failed");
+        wayland_display_unlock(dpy);
+        return false;
+    }
+
+    xdg_surface_add_listener(self->xdg_surface, &xdg_surface_listener, self);
+
+    self->xdg_toplevel = xdg_surface_get_toplevel(self->xdg_surface);
+    if (!self->xdg_toplevel) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "xdg_surface_get_toplevel failed");
+        wayland_display_unlock(dpy);
+        return false;
+    }
+
+    xdg_toplevel_add_listener(self->xdg_toplevel, &xdg_toplevel_listener,
+                              self);
+
+    wayland_display_unlock(dpy);
+
+    if (self->fullscreen)
+        xdg_toplevel_set_fullscreen(self->xdg_toplevel, NULL);
+
+    wl_surface_commit(self->wl_surface);
+
+    return wayland_display_sync(dpy);
+}
+
+/// Validate the platform specific attributes. The render size is zero if
+/// the user did not request one, and the parent is null.
+static bool
+wayland_window_parse_attribs(struct wayland_display *dpy,
+                             const intptr_t attrib_list[],
+                             int32_t *render_width,
+                             int32_t *render_height,
+                             struct wayland_window **parent)
+{
+    intptr_t *attribs = wcore_attrib_list_copy(attrib_list);
+    intptr_t width = 0, height = 0;
+    intptr_t parent_handle = 0;
+    bool has_width;
+    bool ok = false;
+
+    if (!attribs)
+        return false;
+
+    has_width = wcore_attrib_list_pop(attribs, WAFFLE_WINDOW_RENDER_WIDTH,
+                                      &width);
+    wcore_attrib_list_pop(attribs, WAFFLE_WINDOW_RENDER_HEIGHT, &height);
+    wcore_attrib_list_pop(attribs, WAFFLE_WINDOW_PARENT, &parent_handle);
+
+    if (wcore_attrib_list_length(attribs) > 0) {
+        wcore_error_bad_attribute(attribs[0]);
+        goto done;
+    }
+
+    // wcore_window_attrs_parse() has checked the values.
+    if (has_width && !dpy->wp_viewporter) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "WAFFLE_WINDOW_RENDER_WIDTH and "
+                     "WAFFLE_WINDOW_RENDER_HEIGHT require wp_viewporter");
+        goto done;
+    }
+
+    // The API layer has checked that the parent belongs to this display.
+    if (parent_handle && !dpy->wl_subcompositor) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "WAFFLE_WINDOW_PARENT requires wl_subcompositor");
+        goto done;
+    }
+
+    *render_width = (int32_t) width;
+    *render_height = (int32_t) height;
+    *parent = wayland_window(wcore_window((struct waffle_window *)
+                                          parent_handle));
+    ok = true;
+
+done:
+    free(attribs);
+    return ok;
+}
+
 struct wcore_window*
 wayland_window_create(struct wcore_platform *wc_plat,
                       struct wcore_config *wc_config,
@@ -109,16 +317,19 @@ wayland_window_create(struct wcore_platform *wc_plat,
     struct wayland_window *self;
     struct wayland_platform *plat = wayland_platform(wegl_platform(wc_plat));
     struct wayland_display *dpy = wayland_display(wc_config->display);
+    struct wayland_window *parent;
+    int32_t render_width, render_height;
     bool ok = true;
 
-    if (width == -1 && height == -1) {
-        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
-                     "fullscreen window not supported");
+    ok = wayland_window_parse_attribs(dpy, attrib_list,
+                                      &render_width, &render_height,
+                                      &parent);
+    if (!ok)
         return NULL;
-    }
 
-    if (wcore_attrib_list_length(attrib_list) > 0) {
-        wcore_error_bad_attribute(attrib_list[0]);
+    if (width == -1 && height == -1 && !dpy->xdg_wm_base) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "fullscreen window requires xdg_wm_base");
         return NULL;
     }
 
@@ -130,11 +341,13 @@ wayland_window_create(struct wcore_platform *wc_plat,
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wayland compositor not found");
         goto error;
     }
-    if (!dpy->wl_shell) {
+    if (!parent && !dpy->xdg_wm_base && !dpy->wl_shell) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wayland shell not found");
         goto error;
     }
 
+    self->fullscreen = width == -1 && height == -1;
+
     self->wl_surface = wl_compositor_create_surface(dpy->wl_compositor);
     if (!self->wl_surface) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN,
@@ -142,17 +355,76 @@ wayland_window_create(struct wcore_platform *wc_plat,
         goto error;
     }
 
-    self->wl_shell_surface = wl_shell_get_shell_surface(dpy->wl_shell,
-                                                        self->wl_surface);
-    if (!self->wl_shell_surface) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "wl_shell_get_shell_surface failed");
-        goto error;
+    if (parent) {
+        // A subsurface is positioned at the parent's origin and, being
+        // desynchronized, presents independently of the parent. The
+        // compositor may then put it on its own plane.
+        self->wl_subsurface =
+            wl_subcompositor_get_subsurface(dpy->wl_subcompositor,
+                                            self->wl_surface,
+                                            parent->wl_surface);
+        if (!self->wl_subsurface) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "wl_subcompositor_get_subsurface failed");
+            goto error;
+        }
+
+        wl_subsurface_set_desync(self->wl_subsurface);
+    }
+    else if (dpy->xdg_wm_base) {
+        ok = wayland_window_create_xdg_toplevel(self, dpy);
+        if (!ok)
+            goto error;
+
+        if (self->fullscreen) {
+            // A zero size lets the client choose.
+            if (self->configure.width > 0 && self->configure.height > 0) {
+                width = self->configure.width;
+                height = self->configure.height;
+            }
+            else {
+                width = WAYLAND_WINDOW_DEFAULT_WIDTH;
+                height = WAYLAND_WINDOW_DEFAULT_HEIGHT;
+            }
+        }
+    }
+    else {
+        // Keep the dispatch thread from dispatching a ping before the
+        // listener is attached.
+        wayland_display_lock(dpy);
+
+        self->wl_shell_surface = wl_shell_get_shell_surface(dpy->wl_shell,
+                                                            self->wl_surface);
+        if (self->wl_shell_surface) {
+            wl_shell_surface_add_listener(self->wl_shell_surface,
+                                          &shell_surface_listener,
+                                          NULL);
+        }
+
+        wayland_display_unlock(dpy);
+
+        if (!self->wl_shell_surface) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "wl_shell_get_shell_surface failed");
+            goto error;
+        }
     }
 
-    wl_shell_surface_add_listener(self->wl_shell_surface,
-                                  &shell_surface_listener,
-                                  NULL);
+    // The buffer has the render size and the compositor scales it to the
+    // window size.
+    if (render_width > 0) {
+        self->wp_viewport = wp_viewporter_get_viewport(dpy->wp_viewporter,
+                                                       self->wl_surface);
+        if (!self->wp_viewport) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "wp_viewporter_get_viewport failed");
+            goto error;
+        }
+
+        wp_viewport_set_destination(self->wp_viewport, width, height);
+        width = render_width;
+        height = render_height;
+    }
 
     self->wl_window = plat->wl_egl_window_create(self->wl_surface,
                                                  width, height);
@@ -165,6 +437,11 @@ wayland_window_create(struct wcore_platform *wc_plat,
     if (!ok)
         goto error;
 
+    // Acknowledging needs the window's display. Creating the EGLSurface
+    // attaches no buffer, so acknowledging afterwards is still in time.
+    if (self->xdg_surface)
+        wayland_window_apply_configure(self);
+
     ok = wayland_display_sync(dpy);
     if (!ok)
        goto error;
@@ -172,7 +449,63 @@ wayland_window_create(struct wcore_platform *wc_plat,
     return &self->wegl.wcore;
 
 error:
-    wayland_window_destroy(&self->wegl.wcore);
+    wayland_window_free(self, plat, dpy);
+    return NULL;
+}
+
+struct wcore_window*
+wayland_window_adopt_native(struct wcore_platform *wc_plat,
+                            struct wcore_config *wc_config,
+                            union waffle_native_window *native)
+{
+    struct wayland_window *self;
+    struct wayland_platform *plat = wayland_platform(wegl_platform(wc_plat));
+    struct wayland_display *dpy = wayland_display(wc_config->display);
+    struct waffle_wayland_window *n_window = native->wayland;
+    bool ok = true;
+
+    if (!n_window || !n_window->wl_surface) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "native->wayland->wl_surface is null");
+        return NULL;
+    }
+
+    if (n_window->display.wl_display &&
+        n_window->display.wl_display != dpy->wl_display) {
+        wcore_error(WAFFLE_ERROR_BAD_DISPLAY_MATCH);
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (self == NULL)
+        return NULL;
+
+    // The application owns the surface's role, so waffle creates no shell
+    // surface and the window is shown whenever the application maps it.
+    self->wl_surface = n_window->wl_surface;
+    self->adopted = true;
+
+    if (n_window->wl_window) {
+        self->wl_window = n_window->wl_window;
+        self->adopted_wl_window = true;
+    }
+    else {
+        // The application sizes the buffer with waffle_window_resize().
+        self->wl_window = plat->wl_egl_window_create(self->wl_surface, 1, 1);
+        if (!self->wl_window) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN, "wl_egl_window_create failed");
+            goto error;
+        }
+    }
+
+    ok = wegl_window_init(&self->wegl, wc_config, (intptr_t) self->wl_window);
+    if (!ok)
+        goto error;
+
+    return &self->wegl.wcore;
+
+error:
+    wayland_window_free(self, plat, dpy);
     return NULL;
 }
 
@@ -184,7 +517,10 @@ wayland_window_show(struct wcore_window *wc_self)
     struct wayland_display *dpy = wayland_display(wc_self->display);
     bool ok = true;
 
-    wl_shell_surface_set_toplevel(self->wl_shell_surface);
+    // An xdg_toplevel is mapped by its first buffer, and a subsurface along
+    // with its parent.
+    if (self->wl_shell_surface)
+        wl_shell_surface_set_toplevel(self->wl_shell_surface);
 
     ok = wayland_display_sync(dpy);
     if (!ok)
@@ -197,14 +533,21 @@ wayland_window_show(struct wcore_window *wc_self)
 bool
 wayland_window_swap_buffers(struct wcore_window *wc_self)
 {
+    struct wayland_window *self = wayland_window(wc_self);
     struct wayland_display *dpy = wayland_display(wc_self->display);
     bool ok;
 
+    // The ack must precede the commit done by eglSwapBuffers.
+    if (self->xdg_surface)
+        wayland_window_apply_configure(self);
+
     ok = wegl_window_swap_buffers(wc_self);
     if (!ok)
         return false;
 
-    ok = wayland_display_sync(dpy);
+    // Answer pings and the like without a full roundtrip, which would stall
+    // every frame on the compositor.
+    ok = wayland_display_dispatch_pending(dpy);
     if (!ok)
         return false;
 
@@ -220,8 +563,11 @@ wayland_window_resize(struct wcore_window *wc_self,
     struct wayland_platform *plat = wayland_platform(wegl_platform(wc_plat));
     struct wayland_display *dpy = wayland_display(self->wegl.wcore.display);
 
-    plat->wl_egl_window_resize(wayland_window(wc_self)->wl_window,
-                               width, height, 0, 0);
+    if (self->wp_viewport)
+        wp_viewport_set_destination(self->wp_viewport, width, height);
+    else
+        plat->wl_egl_window_resize(wayland_window(wc_self)->wl_window,
+                                   width, height, 0, 0);
 
     if (!wayland_display_sync(dpy))
         return false;
@@ -246,6 +592,9 @@ wayland_window_get_native(struct wcore_window *wc_self)
     n_window->wayland->wl_shell_surface = self->wl_shell_surface;
     n_window->wayland->wl_window = self->wl_window;
     n_window->wayland->egl_surface = self->wegl.egl;
+    n_window->wayland->xdg_surface = self->xdg_surface;
+    n_window->wayland->xdg_toplevel = self->xdg_toplevel;
+    n_window->wayland->wl_subsurface = self->wl_subsurface;
 
     return n_window;
 }
@@ -41,6 +41,39 @@ struct wayland_window {
     struct wl_shell_surface *wl_shell_surface;
     struct wl_egl_window *wl_window;
 
+    /// Set if the window was created with WAFFLE_WINDOW_PARENT. A subsurface
+    /// has no shell surface.
+    struct wl_subsurface *wl_subsurface;
+
+    /// Used instead of wl_shell_surface if the display has an xdg_wm_base.
+    struct xdg_surface *xdg_surface;
+    struct xdg_toplevel *xdg_toplevel;
+
+    /// @brief Scales the buffer to the window size.
+    ///
+    /// Created only if the user requested a render size, in which case
+    /// wl_window has the render size.
+    struct wp_viewport *wp_viewport;
+
+    bool fullscreen;
+
+    /// @brief Set by wayland_window_adopt_native().
+    ///
+    /// The wl_surface, and the wl_egl_window if the application supplied one,
+    /// belong to the application and are not destroyed.
+    bool adopted;
+    bool adopted_wl_window;
+
+    /// @brief The last xdg_surface configure event, not yet acknowledged.
+    ///
+    /// Written by the xdg listeners. Read only under wayland_display_lock().
+    struct {
+        bool pending;
+        uint32_t serial;
+        int32_t width;
+        int32_t height;
+    } configure;
+
     struct wegl_window wegl;
 };
 
@@ -63,6 +96,11 @@ wayland_window_create(struct wcore_platform *wc_plat,
                       int32_t height,
                       const intptr_t attrib_list[]);
 
+struct wcore_window*
+wayland_window_adopt_native(struct wcore_platform *wc_plat,
+                            struct wcore_config *wc_config,
+                            union waffle_native_window *native);
+
 bool
 wayland_window_destroy(struct wcore_window *wc_self);
 
@@ -93,15 +93,27 @@ wayland_wrapper_init(void)
         goto error;                                             \
     }
 
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_callback_interface);
     RETRIEVE_WL_CLIENT_SYMBOL(wl_compositor_interface);
     RETRIEVE_WL_CLIENT_SYMBOL(wl_registry_interface);
     RETRIEVE_WL_CLIENT_SYMBOL(wl_shell_interface);
     RETRIEVE_WL_CLIENT_SYMBOL(wl_shell_surface_interface);
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_subcompositor_interface);
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_subsurface_interface);
     RETRIEVE_WL_CLIENT_SYMBOL(wl_surface_interface);
 
     RETRIEVE_WL_CLIENT_SYMBOL(wl_display_connect);
     RETRIEVE_WL_CLIENT_SYMBOL(wl_display_disconnect);
     RETRIEVE_WL_CLIENT_SYMBOL(wl_display_roundtrip);
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_display_get_fd);
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_display_flush);
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_display_create_queue);
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_display_roundtrip_queue);
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_display_prepare_read_queue);
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_display_read_events);
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_display_cancel_read);
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_display_dispatch_queue_pending);
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_event_queue_destroy);
     RETRIEVE_WL_CLIENT_SYMBOL(wl_proxy_destroy);
     RETRIEVE_WL_CLIENT_SYMBOL(wl_proxy_add_listener);
     RETRIEVE_WL_CLIENT_SYMBOL(wl_proxy_marshal);
@@ -110,6 +122,11 @@ wayland_wrapper_init(void)
     (WAYLAND_VERSION_MINOR > 9 || \
      (WAYLAND_VERSION_MINOR == 9 && WAYLAND_VERSION_MICRO >= 91))
     RETRIEVE_WL_CLIENT_SYMBOL(wl_proxy_marshal_constructor_versioned);
+#endif
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_proxy_set_queue);
+#ifdef WAFFLE_HAS_WL_PROXY_WRAPPER
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_proxy_create_wrapper);
+    RETRIEVE_WL_CLIENT_SYMBOL(wl_proxy_wrapper_destroy);
 #endif
 #undef RETRIEVE_WL_CLIENT_SYMBOL
 
@@ -38,16 +38,20 @@ wayland_wrapper_teardown(void);
 
 
 // Data symbols
+const struct wl_interface *wfl_wl_callback_interface;
 const struct wl_interface *wfl_wl_compositor_interface;
 const struct wl_interface *wfl_wl_registry_interface;
 const struct wl_interface *wfl_wl_shell_interface;
 const struct wl_interface *wfl_wl_shell_surface_interface;
+const struct wl_interface *wfl_wl_subcompositor_interface;
+const struct wl_interface *wfl_wl_subsurface_interface;
 const struct wl_interface *wfl_wl_surface_interface;
 
 
 // Forward declaration of the structs required by the functions
 struct wl_proxy;
 struct wl_display;
+struct wl_event_queue;
 
 
 // Functions
@@ -60,6 +64,36 @@ void
 int
 (*wfl_wl_display_roundtrip)(struct wl_display *display);
 
+int
+(*wfl_wl_display_get_fd)(struct wl_display *display);
+
+int
+(*wfl_wl_display_flush)(struct wl_display *display);
+
+struct wl_event_queue *
+(*wfl_wl_display_create_queue)(struct wl_display *display);
+
+int
+(*wfl_wl_display_roundtrip_queue)(struct wl_display *display,
+                                  struct wl_event_queue *queue);
+
+int
+(*wfl_wl_display_prepare_read_queue)(struct wl_display *display,
+                                     struct wl_event_queue *queue);
+
+int
+(*wfl_wl_display_read_events)(struct wl_display *display);
+
+void
+(*wfl_wl_display_cancel_read)(struct wl_display *display);
+
+int
+(*wfl_wl_display_dispatch_queue_pending)(struct wl_display *display,
+                                         struct wl_event_queue *queue);
+
+void
+(*wfl_wl_event_queue_destroy)(struct wl_event_queue *queue);
+
 
 void
 (*wfl_wl_proxy_destroy)(struct wl_proxy *proxy);
@@ -84,21 +118,55 @@ struct wl_proxy *
 					      uint32_t version,
 					      ...);
 
+void
+(*wfl_wl_proxy_set_queue)(struct wl_proxy *proxy,
+                          struct wl_event_queue *queue);
+
+// Proxy wrappers were added in wayland 1.11. Without them, a proxy can only be
+// moved to waffle's private event queue after it has been created, which
+// races against any other thread that reads events from the display.
+#if WAYLAND_VERSION_MAJOR == 1 && WAYLAND_VERSION_MINOR >= 11
+#define WAFFLE_HAS_WL_PROXY_WRAPPER 1
+
+void *
+(*wfl_wl_proxy_create_wrapper)(void *proxy);
+
+void
+(*wfl_wl_proxy_wrapper_destroy)(void *proxy_wrapper);
+#endif
+
 #ifdef _WAYLAND_CLIENT_H
 #error Do not include wayland-client.h ahead of wayland_wrapper.h
 #endif
 
+#define wl_callback_interface (*wfl_wl_callback_interface)
 #define wl_compositor_interface (*wfl_wl_compositor_interface)
 #define wl_registry_interface (*wfl_wl_registry_interface)
 #define wl_shell_interface (*wfl_wl_shell_interface)
 #define wl_shell_surface_interface (*wfl_wl_shell_surface_interface)
+#define wl_subcompositor_interface (*wfl_wl_subcompositor_interface)
+#define wl_subsurface_interface (*wfl_wl_subsurface_interface)
 #define wl_surface_interface (*wfl_wl_surface_interface)
 
 #define wl_display_connect (*wfl_wl_display_connect)
 #define wl_display_disconnect (*wfl_wl_display_disconnect)
 #define wl_display_roundtrip (*wfl_wl_display_roundtrip)
+#define wl_display_get_fd (*wfl_wl_display_get_fd)
+#define wl_display_flush (*wfl_wl_display_flush)
+#define wl_display_create_queue (*wfl_wl_display_create_queue)
+#define wl_display_roundtrip_queue (*wfl_wl_display_roundtrip_queue)
+#define wl_display_prepare_read_queue (*wfl_wl_display_prepare_read_queue)
+#define wl_display_read_events (*wfl_wl_display_read_events)
+#define wl_display_cancel_read (*wfl_wl_display_cancel_read)
+#define wl_display_dispatch_queue_pending (*wfl_wl_display_dispatch_queue_pending)
+#define wl_event_queue_destroy (*wfl_wl_event_queue_destroy)
 #define wl_proxy_destroy (*wfl_wl_proxy_destroy)
 #define wl_proxy_add_listener (*wfl_wl_proxy_add_listener)
 #define wl_proxy_marshal (*wfl_wl_proxy_marshal)
 #define wl_proxy_marshal_constructor (*wfl_wl_proxy_marshal_constructor)
 #define wl_proxy_marshal_constructor_versioned (*wfl_wl_proxy_marshal_constructor_versioned)
+#define wl_proxy_set_queue (*wfl_wl_proxy_set_queue)
+#ifdef WAFFLE_HAS_WL_PROXY_WRAPPER
+#define wl_proxy_create_wrapper (*wfl_wl_proxy_create_wrapper)
+#define wl_proxy_wrapper_destroy (*wfl_wl_proxy_wrapper_destroy)
+#endif
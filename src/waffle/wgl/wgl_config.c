@@ -79,6 +79,27 @@ wgl_config_check_context_attrs(struct wgl_display *dpy,
         return false;
     }
 
+    if (attrs->context_no_error && !dpy->ARB_create_context_no_error) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "WGL_ARB_create_context_no_error is required in order to "
+                     "request a no-error context");
+        return false;
+    }
+
+    if (attrs->context_release_behavior != WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH &&
+        !dpy->ARB_context_flush_control) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "WGL_ARB_context_flush_control is required in order to "
+                     "request a context release behavior");
+        return false;
+    }
+
+    if (attrs->context_priority != WAFFLE_CONTEXT_PRIORITY_MEDIUM) {
+        wcore_errorf(WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM,
+                     "WGL does not support context priorities");
+        return false;
+    }
+
     switch (attrs->context_api) {
         case WAFFLE_CONTEXT_OPENGL:
             if (wgl_context_needs_arb_create_context(attrs) &&
@@ -35,6 +35,19 @@
 #include "wgl_error.h"
 #include "wgl_window.h"
 
+// Older wglext.h lacks the extension.
+#ifndef WGL_ARB_create_context_no_error
+#define WGL_ARB_create_context_no_error 1
+#define WGL_CONTEXT_OPENGL_NO_ERROR_ARB   0x31B3
+#endif
+
+#ifndef WGL_ARB_context_flush_control
+#define WGL_ARB_context_flush_control 1
+#define WGL_CONTEXT_RELEASE_BEHAVIOR_ARB   0x2097
+#define WGL_CONTEXT_RELEASE_BEHAVIOR_NONE_ARB 0
+#define WGL_CONTEXT_RELEASE_BEHAVIOR_FLUSH_ARB 0x2098
+#endif
+
 bool
 wgl_context_destroy(struct wcore_context *wc_self)
 {
@@ -139,6 +152,16 @@ wgl_context_fill_attrib_list(struct wgl_config *config,
         context_flags |= WGL_CONTEXT_ROBUST_ACCESS_BIT_ARB;
     }
 
+    if (attrs->context_no_error) {
+        attrib_list[i++] = WGL_CONTEXT_OPENGL_NO_ERROR_ARB;
+        attrib_list[i++] = TRUE;
+    }
+
+    if (attrs->context_release_behavior == WAFFLE_CONTEXT_RELEASE_BEHAVIOR_NONE) {
+        attrib_list[i++] = WGL_CONTEXT_RELEASE_BEHAVIOR_ARB;
+        attrib_list[i++] = WGL_CONTEXT_RELEASE_BEHAVIOR_NONE_ARB;
+    }
+
     if (context_flags != 0) {
         attrib_list[i++] = WGL_CONTEXT_FLAGS_ARB;
         attrib_list[i++] = context_flags;
@@ -61,7 +61,10 @@ wgl_context_needs_arb_create_context(const struct wcore_config_attrs *attrs)
          attrs->context_forward_compatible))
         return true;
 
-    if (attrs->context_debug)
+    if (attrs->context_debug || attrs->context_no_error)
+        return true;
+
+    if (attrs->context_release_behavior != WAFFLE_CONTEXT_RELEASE_BEHAVIOR_FLUSH)
         return true;
 
     return false;
@@ -154,6 +154,8 @@ wgl_display_set_extensions(struct wgl_display *dpy)
     dpy->ARB_create_context                     = waffle_is_extension_in_string(extensions, "WGL_ARB_create_context");
     dpy->ARB_create_context_profile             = waffle_is_extension_in_string(extensions, "WGL_ARB_create_context_profile");
     dpy->ARB_create_context_robustness          = waffle_is_extension_in_string(extensions, "WGL_ARB_create_context_robustness");
+    dpy->ARB_create_context_no_error            = waffle_is_extension_in_string(extensions, "WGL_ARB_create_context_no_error");
+    dpy->ARB_context_flush_control              = waffle_is_extension_in_string(extensions, "WGL_ARB_context_flush_control");
     dpy->EXT_create_context_es_profile          = waffle_is_extension_in_string(extensions, "WGL_EXT_create_context_es_profile");
 
     // The WGL_EXT_create_context_es2_profile spec, version 5 2012/04/06,
@@ -142,12 +142,14 @@ static const struct wcore_platform_vtbl wgl_platform_vtbl = {
     .get_proc_address = wgl_get_proc_address,
     .dl_can_open = wgl_dl_can_open,
     .dl_sym = wgl_dl_sym,
+    .enumerate_devices = NULL,
 
     .display = {
         .connect = wgl_display_connect,
         .destroy = wgl_display_destroy,
         .supports_context_api = wgl_display_supports_context_api,
         .get_native = NULL,
+        .adopt_native = NULL,
     },
 
     .config = {
@@ -158,8 +160,10 @@ static const struct wcore_platform_vtbl wgl_platform_vtbl = {
 
     .context = {
         .create = wgl_context_create,
+        .create_no_config = NULL,
         .destroy = wgl_context_destroy,
         .get_native = NULL,
+        .get_attrib = NULL,
     },
 
     .window = {
@@ -169,5 +173,28 @@ static const struct wcore_platform_vtbl wgl_platform_vtbl = {
         .resize = wgl_window_resize,
         .swap_buffers = wgl_window_swap_buffers,
         .get_native = NULL,
+        .create_many = NULL,
+        .get_attrib = NULL,
+        .adopt_native = NULL,
+        .export_frame = NULL,
+        .release_frame = NULL,
+        .map_front_buffer = NULL,
+        .unmap_front_buffer = NULL,
+    },
+
+    .image = {
+        .create_from_dmabuf = NULL,
+        .create_from_texture = NULL,
+        .destroy = NULL,
+        .bind_texture = NULL,
+        .export_dmabuf = NULL,
+    },
+
+    .fence = {
+        .create = NULL,
+        .destroy = NULL,
+        .wait = NULL,
+        .server_wait = NULL,
+        .export_fd = NULL,
     },
 };
@@ -24,8 +24,11 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "wcore_error.h"
+#include "wcore_util.h"
 
 #include "x11_display.h"
 #include "x11_wrappers.h"
@@ -53,6 +56,29 @@ x11_display_init(struct x11_display *self, const char *name)
     return true;
 }
 
+bool
+x11_display_adopt(struct x11_display *self, Display *xlib)
+{
+    assert(self);
+
+    if (!xlib) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "xlib_display is null");
+        return false;
+    }
+
+    self->xcb = wrapped_XGetXCBConnection(xlib);
+    if (!self->xcb) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "XGetXCBConnection failed");
+        return false;
+    }
+
+    self->xlib = xlib;
+    self->screen = DefaultScreen(self->xlib);
+    self->adopted = true;
+
+    return true;
+}
+
 bool
 x11_display_teardown(struct x11_display *self)
 {
@@ -63,9 +89,148 @@ x11_display_teardown(struct x11_display *self)
     if (!self->xlib)
        return !error;
 
+    for (size_t i = 0; i < self->num_colormaps; ++i) {
+        struct x11_colormap *colormap = &self->colormaps[i];
+
+        if (!colormap->checked)
+            xcb_discard_reply(self->xcb, colormap->cookie.sequence);
+
+        xcb_free_colormap(self->xcb, colormap->xcb);
+    }
+
+    free(self->colormaps);
+    self->colormaps = NULL;
+    self->num_colormaps = 0;
+
+    if (self->adopted) {
+        xcb_flush(self->xcb);
+        return !error;
+    }
+
     error = wrapped_XCloseDisplay(self->xlib);
     if (error)
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "XCloseDisplay failed");
 
     return !error;
 }
+
+static struct x11_colormap*
+x11_display_find_colormap(struct x11_display *self, xcb_visualid_t visual)
+{
+    for (size_t i = 0; i < self->num_colormaps; ++i) {
+        if (self->colormaps[i].visual == visual)
+            return &self->colormaps[i];
+    }
+
+    return NULL;
+}
+
+xcb_colormap_t
+x11_display_get_colormap(struct x11_display *self,
+                         xcb_window_t root,
+                         xcb_visualid_t visual)
+{
+    struct x11_colormap *colormap;
+    struct x11_colormap *colormaps;
+
+    colormap = x11_display_find_colormap(self, visual);
+    if (colormap)
+        return colormap->xcb;
+
+    colormaps = wcore_realloc(self->colormaps,
+                              (self->num_colormaps + 1) * sizeof(*colormaps));
+    if (!colormaps)
+        return 0;
+
+    self->colormaps = colormaps;
+
+    colormap = &self->colormaps[self->num_colormaps];
+    colormap->visual = visual;
+    colormap->xcb = xcb_generate_id(self->xcb);
+    if (colormap->xcb <= 0) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "xcb_generate_id() failed");
+        return 0;
+    }
+
+    colormap->cookie = xcb_create_colormap_checked(self->xcb,
+                                                   XCB_COLORMAP_ALLOC_NONE,
+                                                   colormap->xcb,
+                                                   root,
+                                                   visual);
+    colormap->checked = false;
+    self->num_colormaps++;
+
+    return colormap->xcb;
+}
+
+bool
+x11_display_check_colormap(struct x11_display *self, xcb_visualid_t visual)
+{
+    struct x11_colormap *colormap;
+    xcb_generic_error_t *error;
+
+    colormap = x11_display_find_colormap(self, visual);
+    if (!colormap || colormap->checked)
+        return true;
+
+    error = xcb_request_check(self->xcb, colormap->cookie);
+    if (!error) {
+        colormap->checked = true;
+        return true;
+    }
+
+    wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                 "xcb_create_colormap() failed on visual_id=0x%x with "
+                 "error=0x%x\n", visual, error->error_code);
+    free(error);
+
+    // The id names no colormap, so nothing is freed.
+    *colormap = self->colormaps[--self->num_colormaps];
+    return false;
+}
+
+bool
+x11_display_intern_atoms(struct x11_display *self)
+{
+    static const char *names[] = {
+        "_NET_SUPPORTED",
+        "_NET_WM_STATE",
+        "_NET_WM_STATE_FULLSCREEN",
+        "_NET_WM_BYPASS_COMPOSITOR",
+    };
+    xcb_atom_t *atoms[] = {
+        &self->atoms.net_supported,
+        &self->atoms.net_wm_state,
+        &self->atoms.net_wm_state_fullscreen,
+        &self->atoms.net_wm_bypass_compositor,
+    };
+    const size_t num_atoms = sizeof(names) / sizeof(names[0]);
+    xcb_intern_atom_cookie_t cookies[sizeof(names) / sizeof(names[0])];
+    bool ok = true;
+
+    if (self->atoms.interned)
+        return true;
+
+    for (size_t i = 0; i < num_atoms; ++i) {
+        cookies[i] = xcb_intern_atom(self->xcb, false,
+                                     strlen(names[i]), names[i]);
+    }
+
+    for (size_t i = 0; i < num_atoms; ++i) {
+        xcb_intern_atom_reply_t *reply;
+
+        reply = xcb_intern_atom_reply(self->xcb, cookies[i], NULL);
+        if (!reply) {
+            wcore_errorf(WAFFLE_ERROR_UNKNOWN,
+                         "xcb_intern_atom(\"%s\") failed", names[i]);
+            ok = false;
+            continue;
+        }
+
+        *atoms[i] = reply->atom;
+        free(reply);
+    }
+
+    self->atoms.interned = ok;
+    return ok;
+}
@@ -29,14 +29,62 @@
 
 #include <X11/Xlib-xcb.h>
 
+/// A colormap shared by all windows with the same visual.
+struct x11_colormap {
+    xcb_visualid_t visual;
+    xcb_colormap_t xcb;
+
+    /// Checked along with the first window that uses the colormap.
+    xcb_void_cookie_t cookie;
+    bool checked;
+};
+
 struct x11_display {
     Display *xlib;
     xcb_connection_t *xcb;
     int screen;
+
+    /// The connection belongs to the application and is not closed.
+    bool adopted;
+
+    struct x11_colormap *colormaps;
+    size_t num_colormaps;
+
+    /// EWMH atoms, interned by x11_display_intern_atoms().
+    struct {
+        bool interned;
+        xcb_atom_t net_supported;
+        xcb_atom_t net_wm_state;
+        xcb_atom_t net_wm_state_fullscreen;
+        xcb_atom_t net_wm_bypass_compositor;
+    } atoms;
 };
 
 bool
 x11_display_init(struct x11_display *self, const char *name);
 
+/// Wrap the application's Xlib connection without opening a new one.
+bool
+x11_display_adopt(struct x11_display *self, Display *xlib);
+
 bool
 x11_display_teardown(struct x11_display *self);
+
+/// Intern the EWMH atoms, in one round trip, if not yet done.
+bool
+x11_display_intern_atoms(struct x11_display *self);
+
+/// @brief Get the colormap for the visual, creating it if needed.
+///
+/// A new colormap is created without waiting for the server. Check it with
+/// x11_display_check_colormap().
+///
+/// Returns 0 on failure.
+xcb_colormap_t
+x11_display_get_colormap(struct x11_display *self,
+                         xcb_window_t root,
+                         xcb_visualid_t visual);
+
+/// Emit an error and forget the colormap if the server failed to create it.
+bool
+x11_display_check_colormap(struct x11_display *self, xcb_visualid_t visual);
@@ -24,6 +24,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assert.h>
+#include <stdlib.h>
 
 #include "wcore_error.h"
 
@@ -66,62 +67,107 @@ get_xcb_screen(const xcb_setup_t *setup, int screen)
     return NULL;
 }
 
+/// Wait for the error, if any, of a checked request.
+static bool
+x11_window_check_request(struct x11_window *self,
+                         xcb_void_cookie_t cookie,
+                         const char *name)
+{
+    xcb_generic_error_t *error;
+
+    error = xcb_request_check(self->display->xcb, cookie);
+    if (!error)
+        return true;
+
+    wcore_errorf(WAFFLE_ERROR_UNKNOWN, "%s failed: error=0x%x",
+                 name, error->error_code);
+    free(error);
+    return false;
+}
+
+/// Collect the error, if any, of the pending request.
+static bool
+x11_window_check_pending(struct x11_window *self)
+{
+    if (!self->pending.valid)
+        return true;
+
+    self->pending.valid = false;
+    return x11_window_check_request(self, self->pending.cookie,
+                                    self->pending.name);
+}
+
+static void
+x11_window_set_pending(struct x11_window *self,
+                       xcb_void_cookie_t cookie,
+                       const char *name)
+{
+    assert(!self->pending.valid);
+
+    self->pending.valid = true;
+    self->pending.cookie = cookie;
+    self->pending.name = name;
+
+    xcb_flush(self->display->xcb);
+}
+
 bool
-x11_window_init(struct x11_window *self,
-                struct x11_display *dpy,
-                xcb_visualid_t visual_id,
-                int32_t width,
-                int32_t height)
+x11_window_init_begin(struct x11_window *self,
+                      struct x11_display *dpy,
+                      xcb_visualid_t visual_id,
+                      int32_t width,
+                      int32_t height,
+                      bool fullscreen)
 {
-    xcb_colormap_t colormap = 0;
-    xcb_window_t window = 0;
+    xcb_colormap_t colormap;
+    xcb_window_t window;
 
     assert(self);
     assert(dpy);
 
-    bool ok = true;
     xcb_connection_t *conn = dpy->xcb;
 
+    self->display = dpy;
+
     const xcb_setup_t *setup = xcb_get_setup(conn);
     if (!setup){
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "xcb_get_setup() failed");
-        goto error;
+        return false;
     }
 
     const xcb_screen_t *screen = get_xcb_screen(setup, dpy->screen);
     if (!screen) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "failed to get xcb screen");
-        goto error;
+        return false;
     }
 
-    colormap = xcb_generate_id(conn);
+    // Costs a round trip, but only for the display's first fullscreen
+    // window.
+    if (fullscreen && !x11_display_intern_atoms(dpy))
+        return false;
+
+    colormap = x11_display_get_colormap(dpy, screen->root, visual_id);
+    if (!colormap)
+        return false;
+
     window = xcb_generate_id(conn);
-    if (colormap <= 0 || window <= 0) {
+    if (window <= 0) {
         wcore_errorf(WAFFLE_ERROR_UNKNOWN, "xcb_generate_id() failed");
-        goto error;
+        return false;
     }
 
-    xcb_void_cookie_t colormap_cookie = xcb_create_colormap_checked(
-                                            conn,
-                                            XCB_COLORMAP_ALLOC_NONE,
-                                            colormap,
-                                            screen->root,
-                                            visual_id);
-
-    const uint32_t event_mask = XCB_EVENT_MASK_BUTTON_PRESS
-                               | XCB_EVENT_MASK_EXPOSURE
-                               | XCB_EVENT_MASK_KEY_PRESS;
-
+    // Waffle reads no events, so it selects none. Otherwise they would pile
+    // up in the client's queue for as long as the application never pumps
+    // it. An application that wants input selects it on the native window.
+    //
     // Please keep attrib_mask sorted the same as attrib_list.
     const uint32_t attrib_mask = XCB_CW_BORDER_PIXEL
-                               | XCB_CW_EVENT_MASK
                                | XCB_CW_COLORMAP;
 
     // XCB requires that attrib_list be sorted in the same order as
     // `enum xcb_cw_t`.
     const uint32_t attrib_list[] = {
             /* border_pixel */ 0,
-            event_mask,
             colormap,
     };
 
@@ -138,101 +184,240 @@ x11_window_init(struct x11_window *self,
             attrib_mask,
             attrib_list);
 
-    // Check errors.
-    xcb_generic_error_t *error;
-    error = xcb_request_check(conn, colormap_cookie);
-    if (error) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "xcb_create_colormap() failed on visual_id=0x%x with "
-                     "error=0x%x\n", visual_id, error->error_code);
-        goto error;
+    self->xcb = window;
+    self->visual = visual_id;
+    self->fullscreen = fullscreen;
+    x11_window_set_pending(self, create_cookie, "xcb_create_window_checked()");
+
+    return true;
+}
+
+bool
+x11_window_init_finish(struct x11_window *self)
+{
+    bool ok = true;
+
+    // The first check syncs with the server past every request sent so far,
+    // so the remaining checks, and those of other windows begun before this
+    // one, cost no further round trip.
+    ok = x11_display_check_colormap(self->display, self->visual);
+    ok &= x11_window_check_pending(self);
+    if (!ok)
+        return false;
+
+    // The window manager reads the state when the window is first mapped.
+    // A compositor that honors the bypass hint unredirects the window, which
+    // saves a full-screen copy per frame. The window is known to exist, so
+    // these requests cannot fail.
+    if (self->fullscreen) {
+        struct x11_display *dpy = self->display;
+        const uint32_t bypass = 1;
+
+        xcb_change_property(dpy->xcb, XCB_PROP_MODE_REPLACE, self->xcb,
+                            dpy->atoms.net_wm_state, XCB_ATOM_ATOM, 32,
+                            1, &dpy->atoms.net_wm_state_fullscreen);
+        xcb_change_property(dpy->xcb, XCB_PROP_MODE_REPLACE, self->xcb,
+                            dpy->atoms.net_wm_bypass_compositor,
+                            XCB_ATOM_CARDINAL, 32, 1, &bypass);
     }
-    error = xcb_request_check(conn, create_cookie);
-    if (error) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "xcb_create_window_checked() failed: error=0x%x",
-                     error->error_code);
-        goto error;
+
+    return true;
+}
+
+bool
+x11_window_init(struct x11_window *self,
+                struct x11_display *dpy,
+                xcb_visualid_t visual_id,
+                int32_t width,
+                int32_t height,
+                bool fullscreen)
+{
+    return x11_window_init_begin(self, dpy, visual_id, width, height,
+                                 fullscreen) &&
+           x11_window_init_finish(self);
+}
+
+bool
+x11_window_adopt(struct x11_window *self,
+                 struct x11_display *dpy,
+                 xcb_visualid_t visual_id,
+                 Display *xlib,
+                 xcb_window_t window)
+{
+    xcb_get_window_attributes_cookie_t cookie;
+    xcb_get_window_attributes_reply_t *attrs;
+    xcb_generic_error_t *error = NULL;
+    xcb_visualid_t window_visual;
+
+    assert(self);
+    assert(dpy);
+
+    if (xlib && xlib != dpy->xlib) {
+        wcore_error(WAFFLE_ERROR_BAD_DISPLAY_MATCH);
+        return false;
     }
 
-    self->display = dpy;
-    self->xcb = window;
-    goto end;
+    if (!window) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "xlib_window is null");
+        return false;
+    }
 
-error:
-    ok = false;
+    // Collect errors here rather than let them reach Xlib's error handler.
+    cookie = xcb_get_window_attributes(dpy->xcb, window);
+    attrs = xcb_get_window_attributes_reply(dpy->xcb, cookie, &error);
+    if (!attrs) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "xlib_window 0x%x is not a window", window);
+        free(error);
+        return false;
+    }
 
-    if (colormap)
-        xcb_free_colormap(conn, colormap);
+    window_visual = attrs->visual;
+    free(attrs);
 
-    if (window)
-        xcb_destroy_window(conn, window);
+    if (window_visual != visual_id) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER,
+                     "the visual 0x%x of xlib_window does not match the "
+                     "config's visual 0x%x", window_visual, visual_id);
+        return false;
+    }
 
-end:
-    return ok;
+    self->display = dpy;
+    self->xcb = window;
+    self->adopted = true;
+
+    return true;
 }
 
 bool
 x11_window_teardown(struct x11_window *self)
 {
     xcb_void_cookie_t cookie;
-    xcb_generic_error_t *error;
 
     assert(self);
 
-    if (!self->xcb)
+    if (self->pending.valid) {
+        xcb_discard_reply(self->display->xcb, self->pending.cookie.sequence);
+        self->pending.valid = false;
+    }
+
+    if (!self->xcb || self->adopted)
         return true;
 
+    // Nobody can act on an error from destroying the window, so don't wait
+    // for one.
     cookie = xcb_destroy_window_checked(self->display->xcb, self->xcb);
-    error = xcb_request_check(self->display->xcb, cookie);
+    xcb_discard_reply(self->display->xcb, cookie.sequence);
+    xcb_flush(self->display->xcb);
 
-    if (error) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "xcb_destroy_window_checked() failed: error=0x%x",
-                     error->error_code);
-    }
-
-    return !error;
+    return true;
 }
 
 bool
 x11_window_show(struct x11_window *self)
 {
     xcb_void_cookie_t cookie;
-    xcb_generic_error_t *error;
 
     assert(self);
 
     cookie = xcb_map_window_checked(self->display->xcb, self->xcb);
-    error = xcb_request_check(self->display->xcb, cookie);
+    return x11_window_check_request(self, cookie, "xcb_map_window_checked()");
+}
+
+/// Check whether a property of type ATOM contains @a atom.
+static bool
+x11_property_has_atom(xcb_get_property_reply_t *reply, xcb_atom_t atom)
+{
+    const xcb_atom_t *atoms;
+    int length;
+
+    if (!reply || reply->type != XCB_ATOM_ATOM || reply->format != 32)
+        return false;
+
+    atoms = xcb_get_property_value(reply);
+    length = xcb_get_property_value_length(reply) / sizeof(xcb_atom_t);
 
-    if (error) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "xcb_map_window_checked() failed: error=0x%x",
-                     error->error_code);
+    for (int i = 0; i < length; ++i) {
+        if (atoms[i] == atom)
+            return true;
     }
 
-    return !error;
+    return false;
+}
+
+static bool
+x11_window_get_bypass_compositor(struct x11_window *self, bool *value)
+{
+    struct x11_display *dpy = self->display;
+    xcb_get_property_cookie_t state_cookie, supported_cookie;
+    xcb_get_property_reply_t *state, *supported;
+    xcb_generic_error_t *error = NULL;
+
+    *value = false;
+
+    if (!self->fullscreen)
+        return true;
+
+    const xcb_screen_t *screen =
+        get_xcb_screen(xcb_get_setup(dpy->xcb), dpy->screen);
+    if (!screen) {
+        wcore_errorf(WAFFLE_ERROR_UNKNOWN, "failed to get xcb screen");
+        return false;
+    }
+
+    // Both requests share one round trip.
+    state_cookie = xcb_get_property(dpy->xcb, false, self->xcb,
+                                    dpy->atoms.net_wm_state,
+                                    XCB_ATOM_ATOM, 0, 64);
+    supported_cookie = xcb_get_property(dpy->xcb, false, screen->root,
+                                        dpy->atoms.net_supported,
+                                        XCB_ATOM_ATOM, 0, UINT32_MAX / 4);
+
+    // Collect errors here rather than let them reach Xlib's error handler.
+    state = xcb_get_property_reply(dpy->xcb, state_cookie, &error);
+    free(error);
+    error = NULL;
+    supported = xcb_get_property_reply(dpy->xcb, supported_cookie, &error);
+    free(error);
+
+    *value = x11_property_has_atom(state,
+                                   dpy->atoms.net_wm_state_fullscreen) &&
+             x11_property_has_atom(supported,
+                                   dpy->atoms.net_wm_bypass_compositor);
+
+    free(state);
+    free(supported);
+    return true;
+}
+
+bool
+x11_window_get_attrib(struct x11_window *self,
+                      int32_t attrib,
+                      intptr_t *value)
+{
+    bool bypass;
+
+    switch (attrib) {
+        case WAFFLE_WINDOW_BYPASS_COMPOSITOR:
+            if (!x11_window_get_bypass_compositor(self, &bypass))
+                return false;
+            *value = bypass;
+            return true;
+        default:
+            wcore_error_bad_attribute(attrib);
+            return false;
+    }
 }
 
 bool
 x11_window_resize(struct x11_window *self, int32_t width, int32_t height)
 {
     xcb_void_cookie_t cookie;
-    xcb_generic_error_t *error;
 
-    cookie = xcb_configure_window(
+    cookie = xcb_configure_window_checked(
         self->display->xcb, self->xcb,
         XCB_CONFIG_WINDOW_WIDTH | XCB_CONFIG_WINDOW_HEIGHT,
         (uint32_t[]){width, height});
-
-    error = xcb_request_check(self->display->xcb, cookie);
-    if (error) {
-        wcore_errorf(WAFFLE_ERROR_UNKNOWN,
-                     "xcb_configure_window() failed to resize width, "
-                     "height: error=0x%x\n", error->error_code);
-        return false;
-    }
-
-    return true;
+    return x11_window_check_request(self, cookie,
+                                    "xcb_configure_window_checked()");
 }
@@ -34,6 +34,25 @@ struct x11_display;
 struct x11_window {
     struct x11_display *display;
     xcb_window_t xcb;
+    xcb_visualid_t visual;
+
+    /// @brief The window asks the window manager for fullscreen and for
+    /// compositor bypass.
+    bool fullscreen;
+
+    /// The window belongs to the application and is not destroyed.
+    bool adopted;
+
+    /// @brief The create request, until x11_window_init_finish() collects
+    /// its error.
+    ///
+    /// Deferring the check lets waffle_window_create_many() begin every
+    /// window before waiting for any, so that one round trip covers them all.
+    struct {
+        bool valid;
+        xcb_void_cookie_t cookie;
+        const char *name;
+    } pending;
 };
 
 bool
@@ -41,7 +60,34 @@ x11_window_init(struct x11_window *self,
                 struct x11_display *dpy,
                 xcb_visualid_t visual_id,
                 int32_t width,
-                int32_t height);
+                int32_t height,
+                bool fullscreen);
+
+/// @brief Send the requests that create the window, without waiting.
+///
+/// To create many windows in one round trip, begin them all and then finish
+/// them all. On failure, x11_window_teardown() must still be called.
+bool
+x11_window_init_begin(struct x11_window *self,
+                      struct x11_display *dpy,
+                      xcb_visualid_t visual_id,
+                      int32_t width,
+                      int32_t height,
+                      bool fullscreen);
+
+/// Wait for the window's creation and emit an error if it failed.
+bool
+x11_window_init_finish(struct x11_window *self);
+
+/// Wrap the application's window. Its visual must be @a visual_id, the
+/// config's, or rendering to it would fail with a BadMatch that Xlib's
+/// default handler treats as fatal.
+bool
+x11_window_adopt(struct x11_window *self,
+                 struct x11_display *dpy,
+                 xcb_visualid_t visual_id,
+                 Display *xlib,
+                 xcb_window_t window);
 
 bool
 x11_window_teardown(struct x11_window *self);
@@ -49,5 +95,15 @@ x11_window_teardown(struct x11_window *self);
 bool
 x11_window_show(struct x11_window *self);
 
+/// @brief Query a waffle window attribute.
+///
+/// WAFFLE_WINDOW_BYPASS_COMPOSITOR is true if the window manager made the
+/// window fullscreen and supports _NET_WM_BYPASS_COMPOSITOR. That is as close
+/// as EWMH lets a client observe unredirection.
+bool
+x11_window_get_attrib(struct x11_window *self,
+                      int32_t attrib,
+                      intptr_t *value);
+
 bool
 x11_window_resize(struct x11_window *self, int32_t width, int32_t height);
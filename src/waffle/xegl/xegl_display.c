@@ -73,6 +73,38 @@ error:
     return NULL;
 }
 
+struct wcore_display*
+xegl_display_adopt_native(struct wcore_platform *wc_plat,
+                          union waffle_native_display *native)
+{
+    struct xegl_display *self;
+    bool ok = true;
+
+    if (!native->x11_egl) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "native->x11_egl is null");
+        return NULL;
+    }
+
+    self = wcore_calloc(sizeof(*self));
+    if (self == NULL)
+        return NULL;
+
+    ok = x11_display_adopt(&self->x11, native->x11_egl->xlib_display);
+    if (!ok)
+        goto error;
+
+    self->wegl.adopted = true;
+    ok = wegl_display_init(&self->wegl, wc_plat, (intptr_t) self->x11.xlib);
+    if (!ok)
+        goto error;
+
+    return &self->wegl.wcore;
+
+error:
+    xegl_display_destroy(&self->wegl.wcore);
+    return NULL;
+}
+
 void
 xegl_display_fill_native(struct xegl_display *self,
                          struct waffle_x11_egl_display *n_dpy)
@@ -57,6 +57,10 @@ struct wcore_display*
 xegl_display_connect(struct wcore_platform *wc_plat,
                      const char *name);
 
+struct wcore_display*
+xegl_display_adopt_native(struct wcore_platform *wc_plat,
+                          union waffle_native_display *native);
+
 bool
 xegl_display_destroy(struct wcore_display *wc_self);
 
@@ -31,6 +31,8 @@
 
 #include "wegl_config.h"
 #include "wegl_context.h"
+#include "wegl_fence.h"
+#include "wegl_image.h"
 #include "wegl_platform.h"
 #include "wegl_util.h"
 
@@ -147,12 +149,14 @@ static const struct wcore_platform_vtbl xegl_platform_vtbl = {
     .get_proc_address = wegl_get_proc_address,
     .dl_can_open = xegl_dl_can_open,
     .dl_sym = xegl_dl_sym,
+    .enumerate_devices = wegl_platform_enumerate_devices,
 
     .display = {
         .connect = xegl_display_connect,
         .destroy = xegl_display_destroy,
         .supports_context_api = wegl_display_supports_context_api,
         .get_native = xegl_display_get_native,
+        .adopt_native = xegl_display_adopt_native,
     },
 
     .config = {
@@ -163,16 +167,37 @@ static const struct wcore_platform_vtbl xegl_platform_vtbl = {
 
     .context = {
         .create = wegl_context_create,
+        .create_no_config = wegl_context_create_no_config,
         .destroy = wegl_context_destroy,
         .get_native = xegl_context_get_native,
+        .get_attrib = wegl_context_get_attrib,
     },
 
     .window = {
         .create = xegl_window_create,
+        .create_many = xegl_window_create_many,
         .destroy = xegl_window_destroy,
         .show = xegl_window_show,
         .resize = xegl_window_resize,
         .swap_buffers = wegl_window_swap_buffers,
         .get_native = xegl_window_get_native,
+        .get_attrib = xegl_window_get_attrib,
+        .adopt_native = xegl_window_adopt_native,
+    },
+
+    .image = {
+        .create_from_dmabuf = wegl_image_create_from_dmabuf,
+        .create_from_texture = wegl_image_create_from_texture,
+        .destroy = wegl_image_destroy,
+        .bind_texture = wegl_image_bind_texture,
+        .export_dmabuf = wegl_image_export_dmabuf,
+    },
+
+    .fence = {
+        .create = wegl_fence_create,
+        .destroy = wegl_fence_destroy,
+        .wait = wegl_fence_wait,
+        .server_wait = wegl_fence_server_wait,
+        .export_fd = wegl_fence_export_fd,
     },
 };
@@ -47,60 +47,158 @@ xegl_window_destroy(struct wcore_window *wc_self)
     if (!self)
         return ok;
 
-    ok &= wegl_window_teardown(&self->wegl);
+    // A window that failed creation may lack its EGLSurface.
+    if (self->wegl.wcore.display)
+        ok &= wegl_window_teardown(&self->wegl);
+
     ok &= x11_window_teardown(&self->x11);
     free(self);
     return ok;
 }
 
-struct wcore_window*
-xegl_window_create(struct wcore_platform *wc_plat,
-                   struct wcore_config *wc_config,
-                   int32_t width,
-                   int32_t height,
-                   const intptr_t attrib_list[])
+/// Get the X visual of the config's EGLConfig.
+static bool
+xegl_window_get_visual(struct wcore_platform *wc_plat,
+                       struct wcore_config *wc_config,
+                       xcb_visualid_t *visual)
+{
+    struct wegl_platform *plat = wegl_platform(wc_plat);
+    struct wegl_display *dpy = wegl_display(wc_config->display);
+    struct wegl_config *config = wegl_config(wc_config);
+
+    if (!plat->eglGetConfigAttrib(dpy->egl, config->egl,
+                                  EGL_NATIVE_VISUAL_ID, (EGLint*) visual)) {
+        wegl_emit_error(plat, "eglGetConfigAttrib(EGL_NATIVE_VISUAL_ID)");
+        return false;
+    }
+
+    return true;
+}
+
+bool
+xegl_window_create_many(struct wcore_platform *wc_plat,
+                        struct wcore_config *wc_config,
+                        int32_t width,
+                        int32_t height,
+                        const intptr_t attrib_list[],
+                        int32_t count,
+                        struct wcore_window *windows[])
 {
     struct xegl_window *self;
     struct xegl_display *dpy = xegl_display(wc_config->display);
     struct wegl_config *config = wegl_config(wc_config);
-    struct wegl_platform *plat = wegl_platform(wc_plat);
     xcb_visualid_t visual;
+    int32_t i;
+    bool fullscreen = width == -1 && height == -1;
     bool ok = true;
 
-    if (width == -1 && height == -1) {
+    if (fullscreen) {
         width = DisplayWidth(dpy->x11.xlib, dpy->x11.screen);
         height = DisplayHeight(dpy->x11.xlib, dpy->x11.screen);
     }
 
     if (wcore_attrib_list_length(attrib_list) > 0) {
         wcore_error_bad_attribute(attrib_list[0]);
+        return false;
+    }
+
+    ok = xegl_window_get_visual(wc_plat, wc_config, &visual);
+    if (!ok)
+        return false;
+
+    for (i = 0; i < count; ++i)
+        windows[i] = NULL;
+
+    // Send every window's requests before waiting on any of them.
+    for (i = 0; i < count; ++i) {
+        self = wcore_calloc(sizeof(*self));
+        if (self == NULL)
+            goto error;
+
+        windows[i] = &self->wegl.wcore;
+
+        ok = x11_window_init_begin(&self->x11,
+                                   &dpy->x11,
+                                   visual,
+                                   width,
+                                   height,
+                                   fullscreen);
+        if (!ok)
+            goto error;
+    }
+
+    for (i = 0; i < count; ++i) {
+        self = xegl_window(windows[i]);
+
+        ok = x11_window_init_finish(&self->x11);
+        if (!ok)
+            goto error;
+
+        ok = wegl_window_init(&self->wegl,
+                              &config->wcore,
+                              (intptr_t) self->x11.xcb);
+        if (!ok)
+            goto error;
+    }
+
+    return true;
+
+error:
+    for (i = 0; i < count; ++i) {
+        xegl_window_destroy(windows[i]);
+        windows[i] = NULL;
+    }
+    return false;
+}
+
+struct wcore_window*
+xegl_window_create(struct wcore_platform *wc_plat,
+                   struct wcore_config *wc_config,
+                   int32_t width,
+                   int32_t height,
+                   const intptr_t attrib_list[])
+{
+    struct wcore_window *window;
+
+    if (!xegl_window_create_many(wc_plat, wc_config, width, height,
+                                 attrib_list, 1, &window))
+        return NULL;
+
+    return window;
+}
+
+struct wcore_window*
+xegl_window_adopt_native(struct wcore_platform *wc_plat,
+                         struct wcore_config *wc_config,
+                         union waffle_native_window *native)
+{
+    struct xegl_window *self;
+    struct xegl_display *dpy = xegl_display(wc_config->display);
+    xcb_visualid_t visual;
+    bool ok = true;
+
+    if (!native->x11_egl) {
+        wcore_errorf(WAFFLE_ERROR_BAD_PARAMETER, "native->x11_egl is null");
         return NULL;
     }
 
+    ok = xegl_window_get_visual(wc_plat, wc_config, &visual);
+    if (!ok)
+        return NULL;
+
     self = wcore_calloc(sizeof(*self));
     if (self == NULL)
         return NULL;
 
-    ok = plat->eglGetConfigAttrib(dpy->wegl.egl,
-                                  config->egl,
-                                  EGL_NATIVE_VISUAL_ID,
-                                  (EGLint*) &visual);
-    if (!ok) {
-        wegl_emit_error(plat, "eglGetConfigAttrib(EGL_NATIVE_VISUAL_ID)");
-        goto error;
-    }
-
-    ok = x11_window_init(&self->x11,
-                         &dpy->x11,
-                         visual,
-                         width,
-                         height);
+    ok = x11_window_adopt(&self->x11,
+                          &dpy->x11,
+                          visual,
+                          native->x11_egl->display.xlib_display,
+                          native->x11_egl->xlib_window);
     if (!ok)
         goto error;
 
-    ok = wegl_window_init(&self->wegl,
-                          &config->wcore,
-                          (intptr_t) self->x11.xcb);
+    ok = wegl_window_init(&self->wegl, wc_config, (intptr_t) self->x11.xcb);
     if (!ok)
         goto error;
 
@@ -141,3 +239,11 @@ xegl_window_get_native(struct wcore_window *wc_self)
 
     return n_window;
 }
+
+bool
+xegl_window_get_attrib(struct wcore_window *wc_self,
+                       int32_t attrib,
+                       intptr_t *value)
+{
+    return x11_window_get_attrib(&xegl_window(wc_self)->x11, attrib, value);
+}
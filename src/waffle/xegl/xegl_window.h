@@ -60,6 +60,20 @@ xegl_window_create(struct wcore_platform *wc_plat,
                    int32_t height,
                    const intptr_t attrib_list[]);
 
+bool
+xegl_window_create_many(struct wcore_platform *wc_plat,
+                        struct wcore_config *wc_config,
+                        int32_t width,
+                        int32_t height,
+                        const intptr_t attrib_list[],
+                        int32_t count,
+                        struct wcore_window *windows[]);
+
+struct wcore_window*
+xegl_window_adopt_native(struct wcore_platform *wc_plat,
+                         struct wcore_config *wc_config,
+                         union waffle_native_window *native);
+
 bool
 xegl_window_destroy(struct wcore_window *wc_self);
 
@@ -72,3 +86,8 @@ xegl_window_resize(struct wcore_window *wc_self,
 
 union waffle_native_window*
 xegl_window_get_native(struct wcore_window *wc_self);
+
+bool
+xegl_window_get_attrib(struct wcore_window *wc_self,
+                       int32_t attrib,
+                       intptr_t *value);
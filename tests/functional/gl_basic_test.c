@@ -26,17 +26,24 @@
 /// @file
 /// @brief Test basic OpenGL rendering with all platform/gl_api combinations.
 ///
+/// The X11 platforms also run tests of the experimental API, which draw the
+/// same way.
+///
 /// Each test does the following:
 ///     1. Initialize waffle with a platform and gl_api.
 ///     2. Create a context and window.
 ///     3. On the window call waffle_make_current, glClear,
 ///        and waffle_swap_buffers.
-///     4. Verify the window contents with glReadPixels.
+///     4. Verify the window contents with glReadPixels. If the context has
+///        pixel buffer objects and fences, then the readback is asynchronous
+///        and completes after the swap.
 ///     5. Tear down all waffle state.
 
 #include <stdarg.h> // for va_start, va_end
 #include <setjmp.h> // for cmocka.h
 #include <ctype.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -53,6 +60,7 @@
 #include "waffle.h"
 
 #include "gl_basic_cocoa.h"
+#include "gl_basic_x11.h"
 
 enum {
     // Choosing a smaller window would shorten the execution time of pixel
@@ -73,6 +81,7 @@ static const uint8_t    ALPHA_UB    = 0xff;
 
 struct test_state_gl_basic {
     bool initialized;
+    int32_t platform;
     struct waffle_display *dpy;
     struct waffle_config *config;
     struct waffle_window *window;
@@ -103,6 +112,10 @@ typedef float               GLfloat;    /* single precision float */
 typedef float               GLclampf;   /* single precision float in [0,1] */
 typedef double              GLdouble;   /* double precision float */
 typedef double              GLclampd;   /* double precision float in [0,1] */
+typedef ptrdiff_t           GLintptr;
+typedef ptrdiff_t           GLsizeiptr;
+typedef uint64_t            GLuint64;
+typedef struct __GLsync    *GLsync;
 
 #define GL_VERSION                  0x1F02
 #define GL_UNSIGNED_BYTE            0x1401
@@ -112,6 +125,13 @@ typedef double              GLclampd;   /* double precision float in [0,1] */
 #define GL_RGBA                     0x1908
 #define GL_COLOR_BUFFER_BIT         0x00004000
 #define GL_CONTEXT_FLAGS            0x821e
+#define GL_MAP_READ_BIT             0x0001
+#define GL_STREAM_READ              0x88e1
+#define GL_PIXEL_PACK_BUFFER        0x88eb
+#define GL_SYNC_FLUSH_COMMANDS_BIT  0x00000001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_ALREADY_SIGNALED         0x911a
+#define GL_CONDITION_SATISFIED      0x911c
 
 #define GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT 0x00000001
 #define GL_CONTEXT_FLAG_DEBUG_BIT              0x00000002
@@ -137,6 +157,21 @@ static void (APIENTRY *glReadPixels)(GLint x, GLint y,
                                      GLenum format, GLenum type,
                                      GLvoid *pixels );
 
+// For the asynchronous readback.
+static void (APIENTRY *glGenBuffers)(GLsizei n, GLuint *buffers);
+static void (APIENTRY *glDeleteBuffers)(GLsizei n, const GLuint *buffers);
+static void (APIENTRY *glBindBuffer)(GLenum target, GLuint buffer);
+static void (APIENTRY *glBufferData)(GLenum target, GLsizeiptr size,
+                                     const GLvoid *data, GLenum usage);
+static void *(APIENTRY *glMapBufferRange)(GLenum target, GLintptr offset,
+                                          GLsizeiptr length,
+                                          GLbitfield access);
+static GLboolean (APIENTRY *glUnmapBuffer)(GLenum target);
+static GLsync (APIENTRY *glFenceSync)(GLenum condition, GLbitfield flags);
+static GLenum (APIENTRY *glClientWaitSync)(GLsync sync, GLbitfield flags,
+                                           GLuint64 timeout);
+static void (APIENTRY *glDeleteSync)(GLsync sync);
+
 static int
 setup(void **state)
 {
@@ -216,6 +251,7 @@ gl_basic_init(void **state, int32_t waffle_platform)
         0,
     };
 
+    ts->platform = waffle_platform;
     ts->initialized = waffle_init(init_attrib_list);
     if (!ts->initialized) {
         // XXX: does cmocka call teardown if setup fails ?
@@ -252,6 +288,57 @@ gl_basic_fini(void **state)
     return ret ? 0 : -1;
 }
 
+// Read the window into ts->actual_pixels through a pixel buffer object,
+// swapping while the copy is in flight.
+static void
+gl_basic_read_and_swap_async(struct test_state_gl_basic *ts,
+                             int32_t waffle_context_api)
+{
+    const uint8_t *mapped;
+    GLuint buffer;
+    GLsync fence;
+    GLenum status;
+
+    assert_true(glGenBuffers     = get_gl_symbol(waffle_context_api, "glGenBuffers"));
+    assert_true(glDeleteBuffers  = get_gl_symbol(waffle_context_api, "glDeleteBuffers"));
+    assert_true(glBindBuffer     = get_gl_symbol(waffle_context_api, "glBindBuffer"));
+    assert_true(glBufferData     = get_gl_symbol(waffle_context_api, "glBufferData"));
+    assert_true(glMapBufferRange = get_gl_symbol(waffle_context_api, "glMapBufferRange"));
+    assert_true(glUnmapBuffer    = get_gl_symbol(waffle_context_api, "glUnmapBuffer"));
+    assert_true(glFenceSync      = get_gl_symbol(waffle_context_api, "glFenceSync"));
+    assert_true(glClientWaitSync = get_gl_symbol(waffle_context_api, "glClientWaitSync"));
+    assert_true(glDeleteSync     = get_gl_symbol(waffle_context_api, "glDeleteSync"));
+
+    ASSERT_GL(glGenBuffers(1, &buffer));
+    ASSERT_GL(glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer));
+    ASSERT_GL(glBufferData(GL_PIXEL_PACK_BUFFER, sizeof(ts->actual_pixels),
+                           NULL, GL_STREAM_READ));
+
+    // With a pack buffer bound, glReadPixels only queues the copy.
+    ASSERT_GL(glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT,
+                           GL_RGBA, GL_UNSIGNED_BYTE,
+                           NULL));
+    ASSERT_GL(fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+    assert_true(fence);
+
+    assert_true(waffle_window_swap_buffers(ts->window));
+
+    status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+    assert_true(status == GL_ALREADY_SIGNALED ||
+                status == GL_CONDITION_SATISFIED);
+    ASSERT_GL(glDeleteSync(fence));
+
+    ASSERT_GL(mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                                        sizeof(ts->actual_pixels),
+                                        GL_MAP_READ_BIT));
+    assert_true(mapped);
+    memcpy(ts->actual_pixels, mapped, sizeof(ts->actual_pixels));
+
+    ASSERT_GL(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    ASSERT_GL(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+    ASSERT_GL(glDeleteBuffers(1, &buffer));
+}
+
 #define gl_basic_draw(state, ...) \
     \
     gl_basic_draw__(state, (struct gl_basic_draw_args__) { \
@@ -414,10 +501,16 @@ gl_basic_draw__(void **state, struct gl_basic_draw_args__ args)
     // Draw.
     ASSERT_GL(glClearColor(RED_F, GREEN_F, BLUE_F, ALPHA_F));
     ASSERT_GL(glClear(GL_COLOR_BUFFER_BIT));
-    ASSERT_GL(glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT,
-                           GL_RGBA, GL_UNSIGNED_BYTE,
-                           ts->actual_pixels));
-    assert_true(waffle_window_swap_buffers(ts->window));
+
+    if ((waffle_context_api == WAFFLE_CONTEXT_OPENGL && version_10x >= 32) ||
+        (waffle_context_api != WAFFLE_CONTEXT_OPENGL && major >= 3)) {
+        gl_basic_read_and_swap_async(ts, waffle_context_api);
+    } else {
+        ASSERT_GL(glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT,
+                               GL_RGBA, GL_UNSIGNED_BYTE,
+                               ts->actual_pixels));
+        assert_true(waffle_window_swap_buffers(ts->window));
+    }
 
     assert_memory_equal(&ts->actual_pixels, &ts->expect_pixels,
                         sizeof(ts->expect_pixels));
@@ -521,8 +614,366 @@ static void test_gl_basic_gles##waffle_version(void **state)            \
                   .expect_error=WAFFLE_##error);                        \
 }
 
+//
+// Tests of the experimental API, which only the X11 platforms run.
+//
+
+#if defined(WAFFLE_HAS_GLX) || defined(WAFFLE_HAS_X11_EGL)
+
+// Choose an OpenGL config on ts->dpy and get the GL functions that
+// gl_basic_clear_and_check() needs. Skip the test if the platform lacks
+// OpenGL.
+static void
+gl_basic_choose_config(struct test_state_gl_basic *ts)
+{
+    const int32_t config_attrib_list[] = {
+        WAFFLE_CONTEXT_API,     WAFFLE_CONTEXT_OPENGL,
+        WAFFLE_RED_SIZE,        8,
+        WAFFLE_GREEN_SIZE,      8,
+        WAFFLE_BLUE_SIZE,       8,
+        0,
+    };
+
+    ts->config = waffle_config_choose(ts->dpy, config_attrib_list);
+    if (!ts->config) {
+        switch (waffle_error_get_code()) {
+        case WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM:
+            // fall-through
+        case WAFFLE_ERROR_UNKNOWN:
+            skip();
+        default:
+            assert_true(0);
+        }
+    }
+
+    assert_true(glClear         = get_gl_symbol(WAFFLE_CONTEXT_OPENGL, "glClear"));
+    assert_true(glClearColor    = get_gl_symbol(WAFFLE_CONTEXT_OPENGL, "glClearColor"));
+    assert_true(glGetError      = get_gl_symbol(WAFFLE_CONTEXT_OPENGL, "glGetError"));
+    assert_true(glReadPixels    = get_gl_symbol(WAFFLE_CONTEXT_OPENGL, "glReadPixels"));
+}
+
+// Create and show a window of ts->config.
+static struct waffle_window *
+gl_basic_create_window(struct test_state_gl_basic *ts)
+{
+    const intptr_t window_attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH,    WINDOW_WIDTH,
+        WAFFLE_WINDOW_HEIGHT,   WINDOW_HEIGHT,
+        0,
+    };
+    struct waffle_window *window;
+
+    assert_true(window = waffle_window_create2(ts->config, window_attrib_list));
+    assert_true(waffle_window_show(window));
+    return window;
+}
+
+// Connect and create ts->config, ts->window and ts->ctx.
+static void
+gl_basic_create_objects(struct test_state_gl_basic *ts)
+{
+    if (!ts->dpy)
+        assert_true(ts->dpy = waffle_display_connect(NULL));
+
+    gl_basic_choose_config(ts);
+    ts->window = gl_basic_create_window(ts);
+    assert_true(ts->ctx = waffle_context_create(ts->config, NULL));
+}
+
+// Clear @a window with @a ctx, and check the pixels before swapping.
+static void
+gl_basic_clear_and_check(struct test_state_gl_basic *ts,
+                         struct waffle_display *dpy,
+                         struct waffle_window *window,
+                         struct waffle_context *ctx)
+{
+    assert_true(waffle_make_current(dpy, window, ctx));
+
+    ASSERT_GL(glClearColor(RED_F, GREEN_F, BLUE_F, ALPHA_F));
+    ASSERT_GL(glClear(GL_COLOR_BUFFER_BIT));
+
+    memset(ts->actual_pixels, 0x99, sizeof(ts->actual_pixels));
+    ASSERT_GL(glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT,
+                           GL_RGBA, GL_UNSIGNED_BYTE,
+                           ts->actual_pixels));
+    assert_true(waffle_window_swap_buffers(window));
+
+    assert_memory_equal(&ts->actual_pixels, &ts->expect_pixels,
+                        sizeof(ts->expect_pixels));
+}
+
+static void
+test_gl_basic_display_adopt_native(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    union waffle_native_display *native;
+    struct waffle_display *owner;
+
+    assert_true(owner = waffle_display_connect(NULL));
+    assert_true(native = waffle_display_get_native(owner));
+    ts->dpy = waffle_display_adopt_native(native);
+    free(native);
+    assert_true(ts->dpy);
+
+    gl_basic_create_objects(ts);
+    gl_basic_clear_and_check(ts, ts->dpy, ts->window, ts->ctx);
+
+    assert_true(waffle_make_current(ts->dpy, NULL, NULL));
+    assert_true(waffle_window_destroy(ts->window));
+    assert_true(waffle_context_destroy(ts->ctx));
+    assert_true(waffle_config_destroy(ts->config));
+    assert_true(waffle_display_disconnect(ts->dpy));
+    ts->window = NULL;
+    ts->ctx = NULL;
+    ts->config = NULL;
+
+    // The connection must outlive the adopted display.
+    ts->dpy = owner;
+    gl_basic_create_objects(ts);
+    gl_basic_clear_and_check(ts, ts->dpy, ts->window, ts->ctx);
+}
+
+static void
+test_gl_basic_window_adopt_native(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    union waffle_native_window *native;
+    struct waffle_display *other_dpy;
+    struct waffle_config *other_config;
+    struct waffle_context *other_ctx;
+    struct waffle_window *adopted;
+
+    gl_basic_create_objects(ts);
+
+    // Adopt the X window on a second connection, so that EGL does not see
+    // two surfaces for it on one display.
+    assert_true(other_dpy = waffle_display_connect(NULL));
+    assert_true(other_config = waffle_config_choose(other_dpy,
+                    (const int32_t[]) {
+                        WAFFLE_CONTEXT_API,     WAFFLE_CONTEXT_OPENGL,
+                        WAFFLE_RED_SIZE,        8,
+                        WAFFLE_GREEN_SIZE,      8,
+                        WAFFLE_BLUE_SIZE,       8,
+                        0,
+                    }));
+    assert_true(other_ctx = waffle_context_create(other_config, NULL));
+
+    assert_true(native = waffle_window_get_native(ts->window));
+    // The window's connection is not other_dpy's.
+    adopted = waffle_window_adopt_native(other_config, native);
+    assert_null(adopted);
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_DISPLAY_MATCH);
+
+    // A null connection means other_dpy's.
+    gl_basic_x11_clear_xlib_display(ts->platform, native);
+    adopted = waffle_window_adopt_native(other_config, native);
+    free(native);
+    assert_true(adopted);
+
+    gl_basic_clear_and_check(ts, other_dpy, adopted, other_ctx);
+
+    assert_true(waffle_make_current(other_dpy, NULL, NULL));
+    assert_true(waffle_window_destroy(adopted));
+    assert_true(waffle_context_destroy(other_ctx));
+    assert_true(waffle_config_destroy(other_config));
+    assert_true(waffle_display_disconnect(other_dpy));
+
+    // The X window must outlive the adopted window.
+    gl_basic_clear_and_check(ts, ts->dpy, ts->window, ts->ctx);
+}
+
+static void
+test_gl_basic_window_create_many(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    const intptr_t window_attrib_list[] = {
+        WAFFLE_WINDOW_WIDTH,    WINDOW_WIDTH,
+        WAFFLE_WINDOW_HEIGHT,   WINDOW_HEIGHT,
+        0,
+    };
+    struct waffle_window *windows[3] = {0};
+
+    assert_true(ts->dpy = waffle_display_connect(NULL));
+    gl_basic_choose_config(ts);
+    assert_true(ts->ctx = waffle_context_create(ts->config, NULL));
+
+    assert_false(waffle_window_create_many(ts->config, window_attrib_list,
+                                           0, windows));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+
+    assert_true(waffle_window_create_many(ts->config, window_attrib_list,
+                                          3, windows));
+
+    for (int i = 0; i < 3; ++i) {
+        assert_true(windows[i]);
+        assert_true(waffle_window_show(windows[i]));
+        gl_basic_clear_and_check(ts, ts->dpy, windows[i], ts->ctx);
+    }
+
+    assert_true(waffle_make_current(ts->dpy, NULL, NULL));
+    for (int i = 0; i < 3; ++i)
+        assert_true(waffle_window_destroy(windows[i]));
+}
+
+static void
+test_gl_basic_window_bypass_compositor(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_window *fullscreen;
+    intptr_t value = -1;
+
+    gl_basic_create_objects(ts);
+
+    // Only fullscreen windows bypass the compositor.
+    assert_true(waffle_window_get_attrib(ts->window,
+                                         WAFFLE_WINDOW_BYPASS_COMPOSITOR,
+                                         &value));
+    assert_int_equal(value, 0);
+
+    assert_true(fullscreen = waffle_window_create2(ts->config,
+                    (const intptr_t[]) {
+                        WAFFLE_WINDOW_FULLSCREEN, true,
+                        0,
+                    }));
+    assert_true(waffle_window_show(fullscreen));
+
+    // Whether it does depends on the window manager.
+    value = -1;
+    assert_true(waffle_window_get_attrib(fullscreen,
+                                         WAFFLE_WINDOW_BYPASS_COMPOSITOR,
+                                         &value));
+    assert_true(value == 0 || value == 1);
+    assert_true(waffle_window_destroy(fullscreen));
+
+    assert_false(waffle_window_get_attrib(ts->window, WAFFLE_RED_SIZE,
+                                          &value));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+}
+
+static void
+test_gl_basic_enumerate_devices(void **state)
+{
+    struct waffle_device_info devices[8];
+    int32_t num_devices = -1;
+    int32_t n;
+
+    (void) state;
+
+    assert_false(waffle_enumerate_devices(devices, -1, &num_devices));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+
+    // GLX, and EGL without EGL_EXT_device_enumeration, cannot list devices.
+    if (!waffle_enumerate_devices(NULL, 0, &num_devices)) {
+        assert_int_equal(waffle_error_get_code(),
+                         WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        skip();
+    }
+    assert_true(num_devices >= 0);
+
+    n = num_devices < 8 ? num_devices : 8;
+    assert_true(waffle_enumerate_devices(devices, n, &num_devices));
+    assert_true(num_devices >= n);
+
+    // Each GPU is listed once.
+    for (int i = 0; i < n; ++i) {
+        assert_true(devices[i].name[0] != '\0');
+        for (int j = 0; j < i; ++j)
+            assert_string_not_equal(devices[i].name, devices[j].name);
+    }
+}
+
+static void
+test_gl_basic_fence(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+    struct waffle_fence *fence;
+    bool signaled = false;
+    int fd = -1;
+
+    gl_basic_create_objects(ts);
+
+    assert_null(waffle_fence_create(ts->ctx));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_PARAMETER);
+
+    assert_true(waffle_make_current(ts->dpy, ts->window, ts->ctx));
+    ASSERT_GL(glClearColor(RED_F, GREEN_F, BLUE_F, ALPHA_F));
+    ASSERT_GL(glClear(GL_COLOR_BUFFER_BIT));
+
+    fence = waffle_fence_create(ts->ctx);
+    if (!fence) {
+        assert_int_equal(waffle_error_get_code(),
+                         WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        skip();
+    }
+
+    assert_true(waffle_fence_wait(fence, WAFFLE_FENCE_FOREVER, &signaled));
+    assert_true(signaled);
+    assert_true(waffle_fence_server_wait(fence));
+
+    // Only EGL with EGL_ANDROID_native_fence_sync has sync files.
+    if (waffle_fence_export_fd(fence, &fd)) {
+        assert_true(fd >= 0);
+        close(fd);
+    } else {
+        assert_int_equal(waffle_error_get_code(),
+                         WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+    }
+
+    assert_true(waffle_fence_destroy(fence));
+
+    memset(ts->actual_pixels, 0x99, sizeof(ts->actual_pixels));
+    ASSERT_GL(glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT,
+                           GL_RGBA, GL_UNSIGNED_BYTE,
+                           ts->actual_pixels));
+    assert_memory_equal(&ts->actual_pixels, &ts->expect_pixels,
+                        sizeof(ts->expect_pixels));
+}
+
+static void
+test_gl_basic_context_create_no_config(void **state)
+{
+    struct test_state_gl_basic *ts = *state;
+
+    assert_true(ts->dpy = waffle_display_connect(NULL));
+    gl_basic_choose_config(ts);
+    ts->window = gl_basic_create_window(ts);
+
+    // Framebuffer attributes need a config.
+    assert_null(waffle_context_create_no_config(ts->dpy,
+                    (const int32_t[]) {
+                        WAFFLE_CONTEXT_API,     WAFFLE_CONTEXT_OPENGL,
+                        WAFFLE_RED_SIZE,        8,
+                        0,
+                    }, NULL));
+    assert_int_equal(waffle_error_get_code(), WAFFLE_ERROR_BAD_ATTRIBUTE);
+
+    ts->ctx = waffle_context_create_no_config(ts->dpy,
+                    (const int32_t[]) {
+                        WAFFLE_CONTEXT_API,     WAFFLE_CONTEXT_OPENGL,
+                        0,
+                    }, NULL);
+    if (!ts->ctx) {
+        assert_int_equal(waffle_error_get_code(),
+                         WAFFLE_ERROR_UNSUPPORTED_ON_PLATFORM);
+        skip();
+    }
+
+    // The context draws to windows of the display's configs.
+    gl_basic_clear_and_check(ts, ts->dpy, ts->window, ts->ctx);
+}
+
+#define X11_TESTS                                                       \
+        unit_test_make(test_gl_basic_display_adopt_native),             \
+        unit_test_make(test_gl_basic_window_adopt_native),              \
+        unit_test_make(test_gl_basic_window_create_many),               \
+        unit_test_make(test_gl_basic_window_bypass_compositor),         \
+        unit_test_make(test_gl_basic_enumerate_devices),                \
+        unit_test_make(test_gl_basic_fence),                            \
+        unit_test_make(test_gl_basic_context_create_no_config),         \
+
+#endif // WAFFLE_HAS_GLX || WAFFLE_HAS_X11_EGL
 
-#define CREATE_TESTSUITE(waffle_platform, platform)                     \
+#define CREATE_TESTSUITE(waffle_platform, platform, extra_tests)        \
                                                                         \
 static int                                                              \
 setup_##platform(void **state)                                          \
@@ -586,6 +1037,7 @@ testsuite_##platform(void)                                              \
         unit_test_make(test_gl_basic_gles3_fwdcompat),                  \
         unit_test_make(test_gl_basic_gles30),                           \
                                                                         \
+        extra_tests                                                     \
     };                                                                  \
                                                                         \
     return cmocka_run_group_tests_name(#platform, tests, NULL, NULL);   \
@@ -675,7 +1127,7 @@ test_XX_fwdcompat(gles3, OPENGL_ES3, ERROR_UNSUPPORTED_ON_PLATFORM)
 #define unit_test_make(name)                                            \
     cmocka_unit_test_setup_teardown(name, setup_cgl, gl_basic_fini)
 
-CREATE_TESTSUITE(WAFFLE_PLATFORM_CGL, cgl)
+CREATE_TESTSUITE(WAFFLE_PLATFORM_CGL, cgl,)
 
 #undef unit_test_make
 
@@ -686,7 +1138,7 @@ CREATE_TESTSUITE(WAFFLE_PLATFORM_CGL, cgl)
 #define unit_test_make(name)                                            \
     cmocka_unit_test_setup_teardown(name, setup_gbm, gl_basic_fini)
 
-CREATE_TESTSUITE(WAFFLE_PLATFORM_GBM, gbm)
+CREATE_TESTSUITE(WAFFLE_PLATFORM_GBM, gbm,)
 
 #undef unit_test_make
 
@@ -697,7 +1149,7 @@ CREATE_TESTSUITE(WAFFLE_PLATFORM_GBM, gbm)
 #define unit_test_make(name)                                            \
     cmocka_unit_test_setup_teardown(name, setup_glx, gl_basic_fini)
 
-CREATE_TESTSUITE(WAFFLE_PLATFORM_GLX, glx)
+CREATE_TESTSUITE(WAFFLE_PLATFORM_GLX, glx, X11_TESTS)
 
 #undef unit_test_make
 
@@ -708,7 +1160,7 @@ CREATE_TESTSUITE(WAFFLE_PLATFORM_GLX, glx)
 #define unit_test_make(name)                                            \
     cmocka_unit_test_setup_teardown(name, setup_wayland, gl_basic_fini)
 
-CREATE_TESTSUITE(WAFFLE_PLATFORM_WAYLAND, wayland)
+CREATE_TESTSUITE(WAFFLE_PLATFORM_WAYLAND, wayland,)
 
 #undef unit_test_make
 
@@ -719,7 +1171,7 @@ CREATE_TESTSUITE(WAFFLE_PLATFORM_WAYLAND, wayland)
 #define unit_test_make(name)                                            \
     cmocka_unit_test_setup_teardown(name, setup_x11_egl, gl_basic_fini)
 
-CREATE_TESTSUITE(WAFFLE_PLATFORM_X11_EGL, x11_egl)
+CREATE_TESTSUITE(WAFFLE_PLATFORM_X11_EGL, x11_egl, X11_TESTS)
 
 #undef unit_test_make
 
@@ -730,7 +1182,7 @@ CREATE_TESTSUITE(WAFFLE_PLATFORM_X11_EGL, x11_egl)
 #define unit_test_make(name)                                            \
     cmocka_unit_test_setup_teardown(name, setup_wgl, gl_basic_fini)
 
-CREATE_TESTSUITE(WAFFLE_PLATFORM_WGL, wgl)
+CREATE_TESTSUITE(WAFFLE_PLATFORM_WGL, wgl,)
 
 #undef unit_test_make
 
@@ -0,0 +1,58 @@
+// Copyright 2012 Intel Corporation
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// - Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// - Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+// The native X11 headers include GL/gl.h, which gl_basic_test.c must avoid.
+
+#include <stddef.h>
+
+#include "waffle.h"
+
+#ifdef WAFFLE_HAS_GLX
+#include "waffle_glx.h"
+#endif
+#ifdef WAFFLE_HAS_X11_EGL
+#include "waffle_x11_egl.h"
+#endif
+
+#include "gl_basic_x11.h"
+
+void
+gl_basic_x11_clear_xlib_display(int32_t platform,
+                                union waffle_native_window *native)
+{
+    switch (platform) {
+#ifdef WAFFLE_HAS_GLX
+    case WAFFLE_PLATFORM_GLX:
+        native->glx->xlib_display = NULL;
+        break;
+#endif
+#ifdef WAFFLE_HAS_X11_EGL
+    case WAFFLE_PLATFORM_X11_EGL:
+        native->x11_egl->display.xlib_display = NULL;
+        break;
+#endif
+    }
+}